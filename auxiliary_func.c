@@ -1,532 +1,668 @@
-/**
- * Implementation of commands used in the main commands.
- * @file: auxiliary_func.c
- * @author: ist1114613 (João Tamagnini)
- */
-#include "headers.h"
-
-/**
- * @brief Checks if the system has reached the maximum number of batches.
- * 
- * @param sistema Pointer to the vaccination system structure.
- * @param current_language Language for error messages.
- * 
- * @return 1 if valid, 0 if not valid.
- */
-int valid_amount_of_batches(Sistema *sistema,char *current_language) {
-    if (sistema->numLotes >= MAX_LOTES) {
-        Error_exceeded_batch_limit(current_language);
-        return 0;
-    }
-    return 1;
-}
-
-/**
- * @brief Checks if the name of a vaccine is valid,
- * by checking it it is not to long or if it 
- * contains any invalid characthers.
- * 
- * @param nome Name of the vaccine.
- * @param current_language Language for error messages.
- * 
- * @return 1 if valid, 0 if not valid.
- */
-int valid_name(char *nome,char *current_language) {
-    // Check if the name surpasses the maximum length.
-    if (strlen(nome) > MAX_NOME) {
-        Error_invalid_name(current_language);
-        return 0;
-    }
-    // Check if the name contains any invalid characters.
-    for (size_t i = 0; i < strlen(nome); i++) {
-        if (isspace(nome[i])) {
-            Error_invalid_name(current_language);
-            return 0;
-        }
-    }
-    return 1;
-}
-
-/**
- * @brief Checks if the batch is valid,
- * by checking it it is not to long or if it
- * does not consist of Uppercase hexadecimal digits.
- * 
- * @param current_language Language for error messages.
- * @param lote Batch number.
- * 
- * @return 1 if valid, 0 if not valid.
- */
-int valid_batch(char *current_language, char *lote) {
-    // Check if the batch number surpasses the maximum length.
-    if (strlen(lote) > MAX_LOTE) {
-        Error_invalid_batch(current_language);
-        return 0;
-    }
-    /* Check if the batch number contains any invalid characters/non uppercase
-        hexadecimal digits.*/
-    for (size_t i = 0; i < strlen(lote); i++) {
-        if (!isxdigit(lote[i]) || (isalpha(lote[i]) && !isupper(lote[i]))) {
-           Error_invalid_batch(current_language);
-            return 0;
-        }
-    }
-    return 1;
-}
-
-/**
- * @brief Checks if the batch is a duplicate(if the same batch already exists).
- * 
- * @param sistema Pointer to the vaccination system structure.
- * @param lote Batch number.
- * @param current_language Language for error messages.
- * 
- * @return 1 if valid, 0 if not valid.
- */
-int duplicate_batch(Sistema *sistema, char *lote,char *current_language) {
-    // Check if the batch number already exists in the system.
-    for (int i = 0; i < sistema->numLotes; i++) {
-        if (strcmp(sistema->lotes[i].lote, lote) == 0) {
-            Error_duplicated_batch(current_language);
-            return 0;
-        }
-    }
-    return 1;
-}
-
-/**
- * @brief Checks if the quantity of a batch is valid.
- * 
- * @param quantidade Quantity of the batch.
- * @param current_language Language for error messages.
- * 
- * @return 1 if valid, 0 if not valid.
- */
-int valid_quantity(int quantidade,char *current_language) {
-    if (quantidade <= 0) {
-        Error_invalid_quantity(current_language);
-        return 0;
-    }
-    return 1;
-}
-
-/**
- * @brief Checks if the batch exists in the system.
- * 
- * @param sistema Pointer to the vaccination system structure.
- * @param lote Batch number.
- * @param current_language Language for error messages.
- * 
- * @return 1 if valid, 0 if not valid.
- */
-int existing_batch(Sistema *sistema, char *lote, char *current_language) {
-    // Initialize a variable to check if the batch exists.
-    int loteFound = 0;
-    // Check if the batch number exists in the system.
-        for (int i = 0; i < sistema->numInoculacoes; i++) {
-            if (strcmp(sistema->inoculacoes[i].lote, lote) == 0) {
-                loteFound = 1;
-                break;
-            }
-        }
-        // If the batch number does not exist, print an error message.
-        if (!loteFound) {
-            printf("%s: ", lote);
-            Error_non_existent_batch(current_language);
-            return 0;
-        }
-    return 1;
-}
-
-/**
- * @brief Checks if the user has already been vaccinated with the same 
- * vaccine on the same date.
- * 
- * @param sistema Pointer to the vaccination system structure.
- * @param nomeUtente Name of the user.
- * @param current_language Language for error messages.
- * @param loteSelecionado Pointer to the selected batch.
- * 
- * @return 1 if valid, 0 if not valid.
- */
-int already_vaccinated(Sistema *sistema,char *nomeUtente,char *current_language,
-                         Lote *loteSelecionado) {
-    // Check if the user has already been vaccinated and get the name of the vaccine.
-    for (int i = 0; i < sistema->numInoculacoes; i++) {
-        if (strcmp(sistema->inoculacoes[i].nomeUtente, nomeUtente) == 0) {
-            char *nomeVacina = NULL;
-            for (int j = 0; j < sistema->numLotes; j++) {
-                if (strcmp(sistema->lotes[j].lote, sistema->inoculacoes[i].lote) == 0) {
-                    nomeVacina = sistema->lotes[j].nome;
-                    break;
-                }
-            }
-            // Check if the vaccine name matches and if the date is the same.
-            if (nomeVacina != NULL &&
-                strcmp(nomeVacina, loteSelecionado->nome) == 0 &&
-                sistema->inoculacoes[i].dia == sistema->dia_atual &&
-                sistema->inoculacoes[i].mes == sistema->mes_atual &&
-                sistema->inoculacoes[i].ano == sistema->ano_atual) {
-                Error_already_vaccinated(current_language);
-                return 0;
-            }
-        }
-    }
-    return 1;
-}
-
-/**
- * @brief Extracts parameters from the input line for the vaccination command.
- * 
- * @param linha Input line containing the parameters.
- * @param nomeUtente Name of the user.
- * @param nomeVacina Name of the vaccine.
- */
-void extrai_parametros_a(const char *linha, char *nomeUtente, char *nomeVacina){
-    /* Extract the user name and vaccine name from the input line.
-        If the user name is enclosed in double quotes, extract it accordingly.
-        Otherwise, extract it as a regular string.*/
-    if (linha[1] == '"') {
-        char *start = strchr(linha, '"');
-        char *end = strrchr(linha, '"');
-        if (start != NULL && end != NULL && start != end) {
-            strncpy(nomeUtente, start + 1, end-start-1);
-            nomeUtente[end-start-1] = '\0';
-            sscanf(end + 1, "%s", nomeVacina);
-        }
-    } else {
-        sscanf(linha, "%s %s", nomeUtente, nomeVacina);
-    }
-}
-
-/**
- * @brief Checks the system for the vaccine name and sets the selected batch.
- * 
- * @param sistema Pointer to the vaccination system structure.
- * @param nomeVacina Name of the vaccine.
- * @param loteSelecionado Pointer to the selected batch.
- * @param current_language Language for error messages.
- */
-void search_for_vaccine(Sistema *sistema,const char *nomeVacina,
-                        Lote **loteSelecionado, char *current_language) {
-    // Check if there is a valid batch in the system and select it.
-    for (int i = 0; i < sistema->numLotes; i++) {
-        if (strcmp(sistema->lotes[i].nome, nomeVacina) == 0 && 
-            sistema->lotes[i].quantidade > 0 && datavalidaNein(sistema->lotes[i].dia,
-            sistema->lotes[i].mes, sistema->lotes[i].ano, sistema)) {
-            *loteSelecionado = &sistema->lotes[i];
-            return;
-        }
-    }
-    // If no valid batch is found, print an error message.
-    *loteSelecionado = NULL;
-    Error_no_stock(current_language);
-}
-
-/**
- * @brief Deletes inoculations based on the number of arguments.
- * 
- * @param sistema Pointer to the vaccination system structure.
- * @param nomeUtente Name of the user.
- * @param current_language Language for error messages.
- * @param dia Day of the inoculation.
- * @param mes Month of the inoculation.
- * @param ano Year of the inoculation.
- * @param lote Batch number.
- * @param numArgs Number of arguments provided.
- * 
- * @note The function deletes inoculations based on the user name,
- *  or user name and date, or user name, date, and batch number.
- */
-void delete_inocullations(Sistema *sistema, char *nomeUtente, 
-                        char *current_language, int dia, int mes, int ano, char *lote, int numArgs) {
-    // Initialize variables to keep track of the number of deleted inoculations.
-    int aplicacoesDel = 0;
-    int found = 0;
-
-    // Check if the user exists in the system.
-    for (int i = 0; i < sistema->numInoculacoes; i++) {
-        if (strcmp(sistema->inoculacoes[i].nomeUtente, nomeUtente) == 0) {
-            found = 1;
-
-            /* If the user exists, look for inoculations based on the 
-                number of arguments provided.*/
-            if (numArgs == 1 || 
-                (numArgs >= 4 && sistema->inoculacoes[i].dia == dia && 
-                    sistema->inoculacoes[i].mes == mes && sistema->inoculacoes[i].ano == ano) ||
-                (numArgs == 5 && strcmp(sistema->inoculacoes[i].lote, lote) == 0)) {
-                aplicacoesDel++;
-                for (int j = i; j < sistema->numInoculacoes - 1; j++) {
-                    sistema->inoculacoes[j] = sistema->inoculacoes[j + 1];
-                }
-                sistema->numInoculacoes--;
-                i--;
-            }
-        }
-    }
-
-    // If the user does not exist, print an error message.
-    if (!found) {
-        printf("%s: ", nomeUtente);
-        Error_non_existent_user(current_language);
-        return;
-    }
-
-    // Print the number of deleted inoculations.
-    printf("%d\n", aplicacoesDel);
-}
-
-/**
- * @brief Cleans up the system by freeing allocated memory for inoculations.
- * 
- * @param sistema Pointer to the vaccination system structure.
- */
-void cleanupSistema(Sistema *sistema) {
-    // Free the memory allocated for the usernames.
-    for (int i = 0; i < sistema->numInoculacoes; i++) {
-        free(sistema->inoculacoes[i].nomeUtente);
-    }
-    // Free the memory allocated for the inoculations.
-    free(sistema->inoculacoes); 
-}
-
-/**
- * @brief Gets all batches and prints them.
- * 
- * @param sistema Pointer to the vaccination system structure.
- */
-void all_batches(Sistema *sistema) {
-    // Iterate through all batches and print their details.
-    for (int i = 0; i < sistema->numLotes; i++) {
-        printf("%s %s %02d-%02d-%d %d %d\n",sistema->lotes[i].nome,sistema->lotes[i].lote, 
-         sistema->lotes[i].dia, sistema->lotes[i].mes, sistema->lotes[i].ano, 
-         sistema->lotes[i].quantidade,sistema->lotes[i].numInoculacoes);
-     }
-}
-
-/**
- * @brief Gets all inoculations and prints them.
- * 
- * @param sistema Pointer to the vaccination system structure.
- */
-void all_inocullations(Sistema *sistema){
-    // Iterate through all inoculations and print their details.
-    for (int i = 0; i < sistema->numInoculacoes; i++) {
-        printf("%s %s %02d-%02d-%d\n", sistema->inoculacoes[i].nomeUtente,
-            sistema->inoculacoes[i].lote,sistema->inoculacoes[i].dia,
-            sistema->inoculacoes[i].mes, sistema->inoculacoes[i].ano);
-    }
-}
-
-/**
- * @brief Lists all inoculations for a specific user.
- * 
- * @param sistema Pointer to the vaccination system structure.
- * @param nomeUtente Name of the user.
- * @param current_language Language for error messages.
- * 
- * @note If the user does not exist, an error message is printed in the format
- * <username>: no such user.
- */
-void user_inocullations(Sistema *sistema, char *nomeUtente, char *current_language) {
-    int found = 0;
-
-    // Iterate through all inoculations and print the details for the specified user.
-    for (int i = 0; i < sistema->numInoculacoes; i++) {
-        if (strcmp(sistema->inoculacoes[i].nomeUtente, nomeUtente) == 0) {
-            printf("%s %s %02d-%02d-%d\n", sistema->inoculacoes[i].nomeUtente, 
-                sistema->inoculacoes[i].lote,sistema->inoculacoes[i].dia,
-                sistema->inoculacoes[i].mes, sistema->inoculacoes[i].ano);
-            found = 1;
-        }
-    }
-
-    // If the user does not exist, print an error message.
-    if (!found) {
-        printf("%s: ", nomeUtente);
-        Error_non_existent_user(current_language);
-    }
-}
-
-/**
- * @brief Performs the inoculation process for a user.
- * 
- * @param loteSelecionado Pointer to the selected batch.
- * @param sistema Pointer to the vaccination system structure.
- * @param nomeUtente Name of the user.
- * @param current_language Language for error messages.
- */
-void inocullation(Lote *loteSelecionado, Sistema *sistema, char *nomeUtente,
-                 char *current_language) {
-    // Update the values of the selected batch.
-    loteSelecionado->quantidade--;
-    loteSelecionado->numInoculacoes++;
-
-    // Create a new inoculation and copy the username.
-    Inoculacao novaInoculacao;
-    novaInoculacao.nomeUtente = strdup(nomeUtente);
-
-    // Check if memory allocation for the user name was successful.
-    if (novaInoculacao.nomeUtente == NULL) {
-        Error_exceeded_memory_capacity(current_language);
-        return;
-    }
-
-    // Copy the rest of the data to the inoculation structure.
-    strcpy(novaInoculacao.lote, loteSelecionado->lote);
-    novaInoculacao.dia = sistema->dia_atual;
-    novaInoculacao.mes = sistema->mes_atual;
-    novaInoculacao.ano = sistema->ano_atual;
-
-    // Update the inoculations array with the new inoculation.
-    sistema->inoculacoes[sistema->numInoculacoes++] = novaInoculacao;
-
-    // Print the batch number of the inoculation.
-    printf("%s\n", loteSelecionado->lote);
-}
-
-/**
- * @brief Expands the memory allocated for inoculations.
- * 
- * @param sistema Pointer to the vaccination system structure.
- * @param current_language Language for error messages.
- * 
- * @return 1 if successful, 0 if not successful.
- */
-int expandeInoculacoes(Sistema *sistema, char *current_language) {
-    // Increase the capacity of inoculations by 10 times.
-    size_t newCapacity = sistema->capacidadeInoculacoes*10;
-
-    // Reallocate memory for the inoculations array.
-    Inoculacao *newInoculacoes = (Inoculacao *)realloc(sistema->inoculacoes, newCapacity * sizeof(Inoculacao));
-    
-    // Check if memory allocation was successful.
-    if (newInoculacoes == NULL) {
-        Error_exceeded_memory_capacity(current_language);
-        free(sistema->inoculacoes);
-        exit(1); 
-    }
-
-    // Update the system with the new inoculations array and capacity.
-    sistema->inoculacoes = newInoculacoes;
-    sistema->capacidadeInoculacoes = newCapacity;
-    return 1; 
-}
-
-/**
- * @brief Checks if the date is valid.
- * 
- * @param dia Day of the date.
- * @param mes Month of the date.
- * @param ano Year of the date.
- * @param sistema Pointer to the vaccination system structure.
- * @param current_language Language for error messages.
- * 
- * @return 1 if valid, 0 if not valid.
- */
-int datavalida(int dia, int mes, int ano, Sistema *sistema,char *current_language) {
-    // Check if the date is valid based on the current date in the system.
-    if (dia < 1 || dia > 31 || mes < 1 || mes > 12 || ano < sistema->ano_atual ||
-        (ano == sistema->ano_atual && mes == sistema->mes_atual && sistema->dia_atual > dia) ||
-        (ano == sistema->ano_atual && sistema->mes_atual > mes)) {
-        Error_invalid_date(current_language);
-        return 0;
-    }
-
-    // Determine the number of days in the month.
-    int diasNoMes[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
-    
-    // Check for leap year, and adjust February's days accordingly.
-    if (ano % 4 == 0 && (ano % 100 != 0 || ano % 400 == 0)) {
-        diasNoMes[1] = 29; 
-    }
-
-    // Check if the day exceeds the number of days in the month.
-    if (dia > diasNoMes[mes - 1]) {
-        Error_invalid_date(current_language);
-        return 0;
-    }
-    return 1;
-}
-
-int datavalidaNein(int dia, int mes, int ano, Sistema *sistema) {
-    // Check if the date is valid based on the current date in the system.
-    if (dia < 1 || dia > 31 || mes < 1 || mes > 12 || ano < sistema->ano_atual ||
-        (ano == sistema->ano_atual && mes == sistema->mes_atual && sistema->dia_atual > dia) ||
-        (ano == sistema->ano_atual && sistema->mes_atual > mes)) {
-        return 0;
-    }
-
-    // Determine the number of days in the month.
-    int diasNoMes[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
-    
-    // Check for leap year, and adjust February's days accordingly.
-    if (ano % 4 == 0 && (ano % 100 != 0 || ano % 400 == 0)) {
-        diasNoMes[1] = 29; 
-    }
-
-    // Check if the day exceeds the number of days in the month.
-    if (dia > diasNoMes[mes - 1]) {
-        return 0;
-    }
-    return 1;
-}
-
-/**
- * @brief Checks if the date is valid for future dates.
- * 
- * @param dia Day of the date.
- * @param mes Month of the date.
- * @param ano Year of the date.
- * @param sistema Pointer to the vaccination system structure.
- * @param current_language Language for error messages.
- * 
- * @return 1 if valid, 0 if not valid.
- */
-int datavalidaHistory(int dia, int mes, int ano, Sistema *sistema,char *current_language) {
-    // Check if the date is valid based on the current date in the system.
-    if (dia < 1 || dia > 31 || mes < 1 || mes > 12 || ano < sistema->ano_atual ||
-        (ano == sistema->ano_atual && mes == sistema->mes_atual && sistema->dia_atual < dia) ||
-        (ano == sistema->ano_atual && sistema->mes_atual <mes )) {
-        Error_invalid_date(current_language);
-        return 0;
-    }
-    return 1;
-}
-
-/**
- * @brief Sorts the batches by date in ascending order.
- * 
- * @param sistema Pointer to the vaccination system structure.
- */
-void sortLotesPorData(Sistema *sistema) {
-    for (int i = 0; i < sistema->numLotes - 1; i++) {
-        for (int j = 0; j < sistema->numLotes - 1 - i; j++) {
-            
-            // Compare the dates of two batches and swap them if necessary.
-            Lote *lote1 = &sistema->lotes[j];
-            Lote *lote2 = &sistema->lotes[j + 1];
-            if (lote1->ano > lote2->ano || 
-                (lote1->ano == lote2->ano && lote1->mes > lote2->mes) ||
-                (lote1->ano == lote2->ano && lote1->mes == lote2->mes && lote1->dia > lote2->dia) ||
-                (lote1->ano == lote2->ano && lote1->mes == lote2->mes && lote1->dia == lote2->dia 
-                    && strcmp(lote1->lote, lote2->lote) > 0)) {
-                Lote temp = *lote1;
-                *lote1 = *lote2;
-                *lote2 = temp;
-            }
-        }
-    }
-}
-
-/**
- * @brief Clears the input buffer until a newline or EOF is encountered.
- * 
- * @note This function is used to discard any remaining 
- * characters in the input buffer or any input that
- * is invalid at first.
- */
-void clearinput() {
-    char c;
-    while ((c = getchar()) != '\n' && c != EOF);
-}
\ No newline at end of file
+/**
+ * Implementation of commands used in the main commands.
+ * @file: auxiliary_func.c
+ * @author: ist1114613 (João Tamagnini)
+ */
+#include "headers.h"
+
+/**
+ * @brief Checks if the system has reached the maximum number of batches,
+ * when a maximum was configured.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param saida Output where the results are written.
+ * @param current_language Language for error messages.
+ * 
+ * @return 1 if valid, 0 if not valid.
+ */
+int valid_amount_of_batches(Sistema *sistema,Saida *saida, char *current_language) {
+    if (sistema->maxLotes > 0 && sistema->numLotes >= sistema->maxLotes) {
+        Error_exceeded_batch_limit(saida, current_language);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Checks if the name of a vaccine is valid,
+ * by checking it it is not to long or if it 
+ * contains any invalid characthers.
+ * 
+ * @param nome Name of the vaccine.
+ * @param saida Output where the results are written.
+ * @param current_language Language for error messages.
+ * 
+ * @return 1 if valid, 0 if not valid.
+ */
+int valid_name(char *nome,Saida *saida, char *current_language) {
+    // Check if the name surpasses the maximum length.
+    if (strlen(nome) > MAX_NOME) {
+        Error_invalid_name(saida, current_language);
+        return 0;
+    }
+    // Check if the name contains any invalid characters.
+    for (size_t i = 0; i < strlen(nome); i++) {
+        if (isspace(nome[i])) {
+            Error_invalid_name(saida, current_language);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Checks if the batch is valid,
+ * by checking it it is not to long or if it
+ * does not consist of Uppercase hexadecimal digits.
+ * 
+ * @param saida Output where the results are written.
+ * @param current_language Language for error messages.
+ * @param lote Batch number.
+ * 
+ * @return 1 if valid, 0 if not valid.
+ */
+int valid_batch(Saida *saida, char *current_language, char *lote) {
+    // Check if the batch number surpasses the maximum length.
+    if (strlen(lote) > MAX_LOTE) {
+        Error_invalid_batch(saida, current_language);
+        return 0;
+    }
+    /* Check if the batch number contains any invalid characters/non uppercase
+        hexadecimal digits.*/
+    for (size_t i = 0; i < strlen(lote); i++) {
+        if (!isxdigit(lote[i]) || (isalpha(lote[i]) && !isupper(lote[i]))) {
+           Error_invalid_batch(saida, current_language);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Checks if the batch is a duplicate(if the same batch already exists).
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param lote Batch number.
+ * @param saida Output where the results are written.
+ * @param current_language Language for error messages.
+ * 
+ * @return 1 if valid, 0 if not valid.
+ */
+int duplicate_batch(Sistema *sistema, char *lote,Saida *saida, char *current_language) {
+    // Check if the batch number already exists in the system.
+    if (procura_lote(sistema, lote) != -1) {
+        Error_duplicated_batch(saida, current_language);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Checks if the quantity of a batch is valid.
+ * 
+ * @param quantidade Quantity of the batch.
+ * @param saida Output where the results are written.
+ * @param current_language Language for error messages.
+ * 
+ * @return 1 if valid, 0 if not valid.
+ */
+int valid_quantity(int quantidade,Saida *saida, char *current_language) {
+    if (quantidade <= 0) {
+        Error_invalid_quantity(saida, current_language);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Checks if the batch exists in the system.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param lote Batch number.
+ * @param saida Output where the results are written.
+ * @param current_language Language for error messages.
+ * 
+ * @return 1 if valid, 0 if not valid.
+ */
+int existing_batch(Sistema *sistema, char *lote, Saida *saida, char *current_language) {
+    /* Check if the batch number exists in the system and if it
+        was used in any inoculation.*/
+    int slot = procura_lote(sistema, lote);
+    int loteFound = slot != -1 && obtem_lote(sistema, slot)->numInoculacoes > 0;
+
+    // If the batch number does not exist, print an error message.
+    if (!loteFound) {
+        escreve_texto(saida, lote);
+        escreve_texto(saida, ": ");
+        Error_non_existent_batch(saida, current_language);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Checks if the user has already been vaccinated with the same 
+ * vaccine on the same date.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param nomeUtente Name of the user.
+ * @param saida Output where the results are written.
+ * @param current_language Language for error messages.
+ * @param loteSelecionado Pointer to the selected batch.
+ * 
+ * @return 1 if valid, 0 if not valid.
+ */
+int already_vaccinated(Sistema *sistema,char *nomeUtente,Saida *saida, char *current_language,
+                         Lote *loteSelecionado) {
+    int utente = procura_utente(sistema, nomeUtente);
+    if (utente == -1) return 1;
+
+    // Check if the user, vaccine and current date are in the set of vaccinations.
+    ChaveVacinacao chave = { utente, loteSelecionado->vacina, sistema->data_atual };
+    if (contem_vacinacao(&obtem_fatia_utentes(sistema, utente)->vacinacoes, &chave)) {
+        Error_already_vaccinated(saida, current_language);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Extracts parameters from the input line for the vaccination command.
+ * 
+ * @param linha Input line containing the parameters, which is split in place.
+ * @param nomeUtente Pointer set to the name of the user.
+ * @param nomeVacina Pointer set to the name of the vaccine.
+ * 
+ * @note Missing parameters are set to empty strings.
+ */
+void extrai_parametros_a(char *linha, char **nomeUtente, char **nomeVacina){
+    /* Extract the user name and vaccine name from the input line.
+        If the user name is enclosed in double quotes, extract it accordingly.
+        Otherwise, extract it as a regular string.*/
+    char *nome = NULL, *vacina = NULL;
+    if (linha[0] != '\0' && linha[1] == '"') {
+        char *start = strchr(linha, '"');
+        char *end = strrchr(linha, '"');
+        if (start != end) {
+            *end = '\0';
+            nome = start + 1;
+            char *resto = end + 1;
+            vacina = proxima_palavra(&resto);
+        }
+    } else {
+        nome = proxima_palavra(&linha);
+        vacina = proxima_palavra(&linha);
+    }
+    *nomeUtente = nome != NULL ? nome : "";
+    *nomeVacina = vacina != NULL ? vacina : "";
+}
+
+/**
+ * @brief Checks the system for the vaccine and sets the selected batch.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param vacina Id of the vaccine, -1 if it does not exist.
+ * @param loteSelecionado Pointer to the selected batch.
+ * @param saida Output where the results are written.
+ * @param current_language Language for error messages.
+ */
+void search_for_vaccine(Sistema *sistema, int vacina,
+                        Lote **loteSelecionado, Saida *saida, char *current_language) {
+    /* The heap of the vaccine only has batches with stock that are not
+        expired, so the batch that expires first is on its top.*/
+    if (vacina != -1 && sistema->vacinas[vacina].tamanhoHeap > 0) {
+        *loteSelecionado = obtem_lote(sistema, sistema->vacinas[vacina].heap[0]);
+        return;
+    }
+    // If no valid batch is found, print an error message.
+    *loteSelecionado = NULL;
+    Error_no_stock(saida, current_language);
+}
+
+/**
+ * @brief Deletes inoculations based on the number of arguments.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param nomeUtente Name of the user.
+ * @param saida Output where the results are written.
+ * @param current_language Language for error messages.
+ * @param data Date of the inoculation.
+ * @param lote Batch number.
+ * @param numArgs Number of arguments provided.
+ * 
+ * @note The function deletes inoculations based on the user name,
+ *  or user name and date, or user name, date, and batch number.
+ */
+void delete_inocullations(Sistema *sistema, char *nomeUtente, 
+                        Saida *saida, char *current_language, Data data, char *lote, int numArgs) {
+    // Initialize variables to keep track of the number of deleted inoculations.
+    int aplicacoesDel = 0;
+
+    // Check if the user exists in the system.
+    int utente = procura_utente(sistema, nomeUtente);
+    if (utente == -1 || obtem_utente(sistema, utente)->numInoculacoes == 0) {
+        escreve_texto(saida, nomeUtente);
+        escreve_texto(saida, ": ");
+        Error_non_existent_user(saida, current_language);
+        return;
+    }
+
+    /* Look for the inoculations of the user based on the number of 
+        arguments provided and delete them, keeping the others in the
+        list of the user.*/
+    Utente *u = obtem_utente(sistema, utente);
+    ConjuntoVacinacoes *vacinacoes = &obtem_fatia_utentes(sistema, utente)->vacinacoes;
+    int slot = numArgs == 5 ? procura_lote(sistema, lote) : -1;
+    int numRestantes = 0;
+    for (int i = 0; i < u->numInoculacoes; i++) {
+        Inoculacao *inoculacao = obtem_inoculacao(sistema, u->inoculacoes[i]);
+        if (numArgs == 1 || 
+            (numArgs >= 4 && inoculacao->data == data) ||
+            (numArgs == 5 && inoculacao->lote == slot)) {
+            ChaveVacinacao chave = { utente, obtem_lote(sistema, inoculacao->lote)->vacina,
+                inoculacao->data };
+            remove_vacinacao(vacinacoes, &chave);
+            obtem_lote(sistema, inoculacao->lote)->numInoculacoes--;
+            apaga_inoculacao(sistema, u->inoculacoes[i]);
+            aplicacoesDel++;
+        } else {
+            u->inoculacoes[numRestantes++] = u->inoculacoes[i];
+        }
+    }
+    u->numInoculacoes = numRestantes;
+    if (aplicacoesDel > 0) sistema->numAlteracoes++;
+
+    // Print the number of deleted inoculations.
+    escreve_inteiro(saida, aplicacoesDel);
+    escreve_caracter(saida, '\n');
+}
+
+/**
+ * @brief Initializes an empty vaccination system.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param maxLotes Maximum number of batches, 0 if there is no maximum.
+ * 
+ * @return 1 if successful, 0 if there is no memory.
+ * 
+ * @note The inoculations, batches, vaccines, users and indexes start
+ * empty and only allocate memory when they are first used. The number
+ * of changes is increased by every command that changes the system.
+ */
+int inicia_sistema(Sistema *sistema, int maxLotes) {
+    memset(sistema, 0, sizeof(Sistema));
+    sistema->maxLotes = maxLotes;
+    sistema->data_atual = empacota_data(1, 1, 2025);
+    sistema->primeiraInoculacao = sistema->ultimaInoculacao = -1;
+    sistema->inoculacaoLivre = -1;
+    return 1;
+}
+
+/**
+ * @brief Cleans up the system by freeing allocated memory for inoculations,
+ * batches, vaccines and users.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ */
+void cleanupSistema(Sistema *sistema) {
+    // Stop the threads that help format the listings.
+    liberta_formatadores(sistema);
+
+    // Free the memory retired while listings were running.
+    liberta_versoes(sistema);
+
+    // Free the memory allocated for the inoculations.
+    liberta_inoculacoes(sistema);
+
+    // Free the memory allocated for the batches and their indexes.
+    liberta_lotes(sistema);
+
+    // Free the memory allocated for the vaccines and their heaps.
+    for (int i = 0; i < sistema->numVacinas; i++) {
+        free(sistema->vacinas[i].heap);
+    }
+    free(sistema->vacinas);
+    liberta_indice_nomes(&sistema->indiceVacinas);
+
+    // Free the memory allocated for the users of each shard and their inoculations.
+    for (int f = 0; f < NUM_FATIAS; f++) {
+        FatiaUtentes *fatia = &sistema->fatiasUtentes[f];
+        for (int i = 0; i < fatia->numUtentes; i++) {
+            free(fatia->utentes[i].inoculacoes);
+        }
+        free(fatia->utentes);
+        liberta_indice_nomes(&fatia->indice);
+        liberta_vacinacoes(&fatia->vacinacoes);
+        liberta_nomes(&fatia->nomes);
+    }
+
+    // Free the names of the vaccines.
+    liberta_nomes(&sistema->nomes);
+}
+
+/**
+ * @brief Prints the details of a batch as seen by a listing.
+ * 
+ * @param saida Output where the details are written.
+ * @param sistema Pointer to the vaccination system structure.
+ * @param versaoLote Pointer to the batch as seen by the listing.
+ */
+void escreve_lote(Saida *saida, Sistema *sistema, const VersaoLote *versaoLote) {
+    Lote *lote = obtem_lote(sistema, versaoLote->slot);
+    escreve_texto(saida, lote->nome);
+    escreve_caracter(saida, ' ');
+    escreve_texto(saida, lote->lote);
+    escreve_caracter(saida, ' ');
+    escreve_data(saida, versaoLote->data);
+    escreve_caracter(saida, ' ');
+    escreve_inteiro(saida, versaoLote->quantidade);
+    escreve_caracter(saida, ' ');
+    escreve_inteiro(saida, versaoLote->numInoculacoes);
+    escreve_caracter(saida, '\n');
+}
+
+/**
+ * @brief Prints the details of an inoculation.
+ * 
+ * @param saida Output where the details are written.
+ * @param sistema Pointer to the vaccination system structure.
+ * @param inoculacao Pointer to the inoculation.
+ */
+void escreve_inoculacao(Saida *saida, Sistema *sistema, Inoculacao *inoculacao) {
+    escreve_texto(saida, obtem_utente(sistema, inoculacao->utente)->nome);
+    escreve_caracter(saida, ' ');
+    escreve_texto(saida, obtem_lote(sistema, inoculacao->lote)->lote);
+    escreve_caracter(saida, ' ');
+    escreve_data(saida, inoculacao->data);
+    escreve_caracter(saida, '\n');
+}
+
+/**
+ * @brief Takes a version of the system for a listing of the batches,
+ * and copies the values that change of all batches in date order, so
+ * the listing shows them as they were at its version.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param lotes Pointer set to the copies, which the caller frees.
+ * @param versao Pointer set to the version of the listing, which the
+ * caller ends with termina_leitura.
+ * 
+ * @return The number of batches, -1 if there is no memory.
+ * 
+ * @note The system is only locked while the batches are copied, and
+ * the vaccinations change their stock with the inoculations locked.
+ */
+int le_lotes(Sistema *sistema, VersaoLote **lotes, unsigned int *versao) {
+    bloqueia_sistema(sistema, 0);
+    bloqueia(&sistema->bloqueioInoculacoes, sistema->concorrente);
+    int numLotes = sistema->numLotes;
+    *lotes = (VersaoLote *)malloc((numLotes > 0 ? numLotes : 1) * sizeof(VersaoLote));
+    if (*lotes != NULL) {
+        *versao = inicia_leitura(sistema);
+        for (int i = 0; i < numLotes; i++) {
+            Lote *lote = obtem_lote(sistema, sistema->ordemLotes[i]);
+            VersaoLote *copia = &(*lotes)[i];
+            copia->slot = lote->slot;
+            copia->data = lote->data;
+            copia->quantidade = lote->quantidade;
+            copia->numInoculacoes = lote->numInoculacoes;
+        }
+    }
+    desbloqueia(&sistema->bloqueioInoculacoes, sistema->concorrente);
+    desbloqueia_sistema(sistema);
+    return *lotes != NULL ? numLotes : -1;
+}
+
+/**
+ * @brief Gets all batches and prints them sorted by date.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param saida Output where the results are written.
+ * @param current_language Language for error messages.
+ */
+void all_batches(Sistema *sistema, Saida *saida, char *current_language) {
+    VersaoLote *lotes;
+    unsigned int versao;
+    int numLotes = le_lotes(sistema, &lotes, &versao);
+    if (numLotes == -1) {
+        Error_exceeded_memory_capacity(saida, current_language);
+        return;
+    }
+
+    // Iterate through all batches by date order and print their details.
+    for (int i = 0; i < numLotes; i++) {
+        escreve_lote(saida, sistema, &lotes[i]);
+    }
+    termina_leitura(sistema, versao);
+    free(lotes);
+}
+
+/**
+ * @brief Gets all inoculations and prints them.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param saida Output where the results are written.
+ * 
+ * @note The system is only locked while the version of the listing
+ * is taken, and the inoculations added or deleted after it are not
+ * shown or still shown. With the threads that format free, the
+ * positions of the inoculations shown are collected in rounds, which
+ * the threads format together.
+ */
+void all_inocullations(Sistema *sistema, Saida *saida){
+    bloqueia_sistema(sistema, 0);
+    bloqueia(&sistema->bloqueioInoculacoes, sistema->concorrente);
+    unsigned int versao = inicia_leitura(sistema);
+    int primeira = sistema->primeiraInoculacao;
+    desbloqueia(&sistema->bloqueioInoculacoes, sistema->concorrente);
+    desbloqueia_sistema(sistema);
+    int *posicoes = reserva_formatadores(sistema);
+    int numPosicoes = 0;
+
+    /* Follow the inoculations in the order they were added and print the
+        details of those alive at the version, up to the first added after it.*/
+    for (int i = primeira; i != -1; ) {
+        Inoculacao *inoculacao = obtem_inoculacao(sistema, i);
+        if (inoculacao->criada > versao) break;
+        if (inoculacao_visivel(inoculacao, versao)) {
+            if (posicoes == NULL) {
+                escreve_inoculacao(saida, sistema, inoculacao);
+            } else {
+                posicoes[numPosicoes++] = i;
+                if (numPosicoes == sistema->formatadores.capacidadePosicoes) {
+                    formata_inoculacoes(sistema, saida, numPosicoes);
+                    numPosicoes = 0;
+                }
+            }
+        }
+        i = __atomic_load_n(&inoculacao->seguinte, __ATOMIC_ACQUIRE);
+    }
+    if (posicoes != NULL) {
+        formata_inoculacoes(sistema, saida, numPosicoes);
+        devolve_formatadores(sistema);
+    }
+    termina_leitura(sistema, versao);
+}
+
+/**
+ * @brief Lists all inoculations for a specific user.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param nomeUtente Name of the user.
+ * @param saida Output where the results are written.
+ * @param current_language Language for error messages.
+ * 
+ * @note If the user does not exist, an error message is printed in the format
+ * <username>: no such user. The system is only locked while the list of
+ * the user is copied and the version of the listing taken.
+ */
+void user_inocullations(Sistema *sistema, char *nomeUtente, Saida *saida, char *current_language) {
+    pthread_mutex_t *bloqueioUtente = &sistema->fatiasUtentes[fatia_utente(nomeUtente)].bloqueio;
+    bloqueia_sistema(sistema, 0);
+    bloqueia(bloqueioUtente, sistema->concorrente);
+    int utente = procura_utente(sistema, nomeUtente);
+    Utente *u = utente != -1 ? obtem_utente(sistema, utente) : NULL;
+    int numInoculacoes = u != NULL ? u->numInoculacoes : 0;
+    int found = numInoculacoes > 0;
+    int *inoculacoes = found ? (int *)malloc(numInoculacoes * sizeof(int)) : NULL;
+    unsigned int versao = 0;
+    if (inoculacoes != NULL) {
+        memcpy(inoculacoes, u->inoculacoes, numInoculacoes * sizeof(int));
+        bloqueia(&sistema->bloqueioInoculacoes, sistema->concorrente);
+        versao = inicia_leitura(sistema);
+        desbloqueia(&sistema->bloqueioInoculacoes, sistema->concorrente);
+    }
+    desbloqueia(bloqueioUtente, sistema->concorrente);
+    desbloqueia_sistema(sistema);
+    if (found && inoculacoes == NULL) {
+        Error_exceeded_memory_capacity(saida, current_language);
+        return;
+    }
+
+    // Iterate through the inoculations of the user and print their details.
+    for (int i = 0; found && i < numInoculacoes; i++) {
+        escreve_inoculacao(saida, sistema, obtem_inoculacao(sistema, inoculacoes[i]));
+    }
+    if (found) {
+        termina_leitura(sistema, versao);
+        free(inoculacoes);
+    }
+
+    // If the user does not exist, print an error message.
+    if (!found) {
+        escreve_texto(saida, nomeUtente);
+        escreve_texto(saida, ": ");
+        Error_non_existent_user(saida, current_language);
+    }
+}
+
+/**
+ * @brief Performs the inoculation process for a user.
+ * 
+ * @param loteSelecionado Pointer to the selected batch.
+ * @param sistema Pointer to the vaccination system structure.
+ * @param nomeUtente Name of the user.
+ * @param registo Record of the command for the journal, or NULL.
+ * @param saida Output where the results are written.
+ * @param current_language Language for error messages.
+ * 
+ * @note While the system is shared, the shards of the vaccine and of
+ * the user must be locked. The inoculation is added, the stock of the
+ * batch taken and the record appended to the journal under the lock of
+ * the inoculations, so the journal keeps the order of the inoculations
+ * and the listings see the inoculation and the stock change together.
+ */
+void inocullation(Lote *loteSelecionado, Sistema *sistema, char *nomeUtente,
+                  RegistoJournal *registo, Saida *saida, char *current_language) {
+    // Register the user and the vaccination, with room for one more inoculation of the user.
+    int utente = regista_utente(sistema, nomeUtente);
+    ChaveVacinacao chave = { utente, loteSelecionado->vacina, sistema->data_atual };
+    ConjuntoVacinacoes *vacinacoes =
+        utente != -1 ? &obtem_fatia_utentes(sistema, utente)->vacinacoes : NULL;
+    if (utente == -1 || !insere_vacinacao(vacinacoes, &chave)) {
+        Error_exceeded_memory_capacity(saida, current_language);
+        return;
+    }
+    if (!reserva_inoculacao_utente(sistema, utente)) {
+        remove_vacinacao(vacinacoes, &chave);
+        Error_exceeded_memory_capacity(saida, current_language);
+        return;
+    }
+
+    /* Add the new inoculation, the name of the user and the batch are
+        kept only once in the system so the inoculation only keeps their ids.*/
+    bloqueia(&sistema->bloqueioInoculacoes, sistema->concorrente);
+    int pos = nova_inoculacao(sistema, utente, loteSelecionado->slot, sistema->data_atual);
+    if (pos != -1) {
+        loteSelecionado->quantidade--;
+        loteSelecionado->numInoculacoes++;
+        sistema->numAlteracoes++;
+        if (registo != NULL) acrescenta_registo_journal(registo);
+    }
+    desbloqueia(&sistema->bloqueioInoculacoes, sistema->concorrente);
+    if (pos == -1) {
+        remove_vacinacao(vacinacoes, &chave);
+        Error_exceeded_memory_capacity(saida, current_language);
+        return;
+    }
+    adiciona_inoculacao_utente(sistema, utente, pos);
+
+    // The batch leaves the heap of its vaccine when its stock runs out.
+    if (loteSelecionado->quantidade == 0) {
+        remove_heap_lote(sistema, loteSelecionado->slot);
+    }
+
+    // Print the batch number of the inoculation.
+    escreve_linha(saida, loteSelecionado->lote);
+}
+
+/**
+ * @brief Checks if the date is valid.
+ * 
+ * @param dia Day of the date.
+ * @param mes Month of the date.
+ * @param ano Year of the date.
+ * @param sistema Pointer to the vaccination system structure.
+ * @param saida Output where the results are written.
+ * @param current_language Language for error messages.
+ * 
+ * @return 1 if valid, 0 if not valid.
+ */
+int datavalida(int dia, int mes, int ano, Sistema *sistema,Saida *saida, char *current_language) {
+    // Check if the date exists and is not before the current date of the system.
+    if (!data_existe(dia, mes, ano) || empacota_data(dia, mes, ano) < sistema->data_atual) {
+        Error_invalid_date(saida, current_language);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Checks if a packed date is not before the current date of the system.
+ * 
+ * @param data Packed date.
+ * @param sistema Pointer to the vaccination system structure.
+ * 
+ * @return 1 if valid, 0 if not valid.
+ */
+int datavalidaNein(Data data, Sistema *sistema) {
+    return data >= sistema->data_atual;
+}
+
+/**
+ * @brief Checks if the date is valid for future dates.
+ * 
+ * @param dia Day of the date.
+ * @param mes Month of the date.
+ * @param ano Year of the date.
+ * @param sistema Pointer to the vaccination system structure.
+ * @param saida Output where the results are written.
+ * @param current_language Language for error messages.
+ * 
+ * @return 1 if valid, 0 if not valid.
+ */
+int datavalidaHistory(int dia, int mes, int ano, Sistema *sistema,Saida *saida, char *current_language) {
+    // Check if the date is valid based on the current date in the system.
+    int ano_atual = data_ano(sistema->data_atual);
+    if (dia < 1 || dia > 31 || mes < 1 || mes > 12 || ano < ano_atual ||
+        (ano == ano_atual && empacota_data(dia, mes, ano) > sistema->data_atual)) {
+        Error_invalid_date(saida, current_language);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Removes a batch from the system. The other batches keep
+ * their slots, so their ids stay valid, and its slot is reused once
+ * no listing can read it.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param slot Slot of the batch to remove.
+ */
+void remove_lote(Sistema *sistema, int slot) {
+    remove_ordem_lote(sistema, slot);
+    remove_indice_lote(sistema, obtem_lote(sistema, slot)->lote);
+    sistema->numLotes--;
+    retira_lote(sistema, slot);
+}
@@ -0,0 +1,223 @@
+/**
+ * Load-test client of the server of the vaccination system.
+ * 
+ * Creates a batch of each vaccine, then opens many connections to the
+ * socket of the server and has each one send inoculations of its own
+ * users, keeping a window of commands sent and not answered yet. Each
+ * inoculation is answered with one line, so the commands are counted
+ * as answered by counting lines. Prints the number of connections and
+ * of commands, the time they took and the aggregate throughput.
+ * @file: carga.c
+ * @author: ist1114613 (João Tamagnini)
+ */
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+/// Maximum length of a command sent by the client, with its newline.
+#define MAX_COMANDO 64
+
+/// Structure representing a connection of the client.
+typedef struct {
+    int fd;
+    long long enviados, respondidos;
+    char *buffer;
+    int tamanho, escritos;
+} Ligacao;
+
+/**
+ * @brief Gets the current time in seconds.
+ * 
+ * @return The seconds since an arbitrary point.
+ */
+static double agora(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Connects to the socket of the server.
+ * 
+ * @param caminho Path of the socket.
+ * 
+ * @return The file descriptor of the connection, or -1 on failure.
+ */
+static int liga(const char *caminho) {
+    struct sockaddr_un endereco;
+    if (strlen(caminho) >= sizeof(endereco.sun_path)) return -1;
+    memset(&endereco, 0, sizeof(endereco));
+    endereco.sun_family = AF_UNIX;
+    strcpy(endereco.sun_path, caminho);
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    if (connect(fd, (struct sockaddr *)&endereco, sizeof(endereco)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * @brief Creates a batch of each vaccine with enough doses for the test,
+ * and waits for their answers.
+ * 
+ * @param caminho Path of the socket.
+ * @param numVacinas Number of vaccines.
+ * @param execucao Number that makes the batches of this run unique.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+static int cria_lotes(const char *caminho, int numVacinas, unsigned int execucao) {
+    int fd = liga(caminho);
+    if (fd < 0) return 0;
+    FILE *f = fdopen(fd, "r+");
+    if (f == NULL) {
+        close(fd);
+        return 0;
+    }
+    for (int v = 0; v < numVacinas; v++) {
+        fprintf(f, "c %X%04X 31-12-2099 1000000000 V%d\n", execucao, v, v);
+    }
+    fprintf(f, "q\n");
+    fflush(f);
+    int linhas = 0, c;
+    while ((c = fgetc(f)) != EOF) linhas += c == '\n';
+    fclose(f);
+    return linhas == numVacinas;
+}
+
+/**
+ * @brief Adds inoculations to the buffer of a connection, up to the
+ * window of unanswered commands and the number of commands to send.
+ * 
+ * @param ligacao Pointer to the connection.
+ * @param numero Number of the connection.
+ * @param numComandos Number of commands to send.
+ * @param janela Maximum number of unanswered commands.
+ * @param numVacinas Number of vaccines.
+ * @param execucao Number that makes the users of this run unique.
+ */
+static void enche(Ligacao *ligacao, int numero, long long numComandos, int janela,
+                  int numVacinas, unsigned int execucao) {
+    // Only the commands not written yet are kept in the buffer.
+    memmove(ligacao->buffer, ligacao->buffer + ligacao->escritos,
+            ligacao->tamanho - ligacao->escritos);
+    ligacao->tamanho -= ligacao->escritos;
+    ligacao->escritos = 0;
+    while (ligacao->enviados < numComandos && ligacao->enviados - ligacao->respondidos < janela) {
+        ligacao->tamanho += snprintf(ligacao->buffer + ligacao->tamanho, MAX_COMANDO,
+                                     "a x%Xc%du%lld V%lld\n", execucao, numero,
+                                     ligacao->enviados, ligacao->enviados % numVacinas);
+        ligacao->enviados++;
+    }
+}
+
+/**
+ * @brief Prints how to use the client.
+ * 
+ * @param programa Name of the program.
+ */
+static void uso(const char *programa) {
+    fprintf(stderr,
+        "usage: %s -s socket [-c connections] [-n commands per connection]\n"
+        "          [-j window] [-v vaccines]\n", programa);
+}
+
+/**
+ * @brief Main function of the client.
+ * 
+ * @param argc Number of command-line arguments.
+ * @param argv Array of command-line argument strings.
+ * 
+ * @return 0 on success, 1 on invalid arguments or failure.
+ */
+int main(int argc, char *argv[]) {
+    const char *caminho = NULL;
+    int numLigacoes = 1, janela = 32, numVacinas = 10;
+    long long numComandos = 10000;
+    int opcao;
+    while ((opcao = getopt(argc, argv, "s:c:n:j:v:")) != -1) {
+        switch (opcao) {
+            case 's': caminho = optarg; break;
+            case 'c': numLigacoes = atoi(optarg); break;
+            case 'n': numComandos = atoll(optarg); break;
+            case 'j': janela = atoi(optarg); break;
+            case 'v': numVacinas = atoi(optarg); break;
+            default: uso(argv[0]); return 1;
+        }
+    }
+    if (caminho == NULL || numLigacoes < 1 || numComandos < 1 || janela < 1 || numVacinas < 1) {
+        uso(argv[0]);
+        return 1;
+    }
+
+    unsigned int execucao = (unsigned int)getpid() ^ (unsigned int)time(NULL);
+    if (!cria_lotes(caminho, numVacinas, execucao)) {
+        fprintf(stderr, "%s: cannot create the batches on %s\n", argv[0], caminho);
+        return 1;
+    }
+    Ligacao *ligacoes = (Ligacao *)calloc(numLigacoes, sizeof(Ligacao));
+    struct pollfd *eventos = (struct pollfd *)calloc(numLigacoes, sizeof(struct pollfd));
+    if (ligacoes == NULL || eventos == NULL) return 1;
+    for (int i = 0; i < numLigacoes; i++) {
+        ligacoes[i].fd = liga(caminho);
+        ligacoes[i].buffer = (char *)malloc((size_t)janela * MAX_COMANDO + MAX_COMANDO);
+        if (ligacoes[i].fd < 0 || ligacoes[i].buffer == NULL) {
+            fprintf(stderr, "%s: cannot open connection %d to %s\n", argv[0], i, caminho);
+            return 1;
+        }
+        fcntl(ligacoes[i].fd, F_SETFL, fcntl(ligacoes[i].fd, F_GETFL) | O_NONBLOCK);
+    }
+
+    double inicio = agora();
+    int ativas = numLigacoes;
+    char resposta[1 << 16];
+    while (ativas > 0) {
+        for (int i = 0; i < numLigacoes; i++) {
+            Ligacao *ligacao = &ligacoes[i];
+            enche(ligacao, i, numComandos, janela, numVacinas, execucao);
+            eventos[i].fd = ligacao->respondidos < numComandos ? ligacao->fd : -1;
+            eventos[i].events = POLLIN | (ligacao->escritos < ligacao->tamanho ? POLLOUT : 0);
+        }
+        if (poll(eventos, numLigacoes, -1) < 0) {
+            if (errno == EINTR) continue;
+            return 1;
+        }
+        for (int i = 0; i < numLigacoes; i++) {
+            Ligacao *ligacao = &ligacoes[i];
+            if (eventos[i].revents & POLLOUT) {
+                ssize_t n = write(ligacao->fd, ligacao->buffer + ligacao->escritos,
+                                  ligacao->tamanho - ligacao->escritos);
+                if (n > 0) ligacao->escritos += (int)n;
+            }
+            if (eventos[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+                ssize_t n = read(ligacao->fd, resposta, sizeof(resposta));
+                if (n <= 0 && !(n < 0 && errno == EAGAIN)) {
+                    fprintf(stderr, "%s: connection %d closed by the server\n", argv[0], i);
+                    return 1;
+                }
+                for (ssize_t j = 0; j < n; j++) ligacao->respondidos += resposta[j] == '\n';
+                if (ligacao->respondidos == numComandos) ativas--;
+            }
+        }
+    }
+    double segundos = agora() - inicio;
+
+    long long total = (long long)numLigacoes * numComandos;
+    printf("%d %lld %.6f %.0f\n", numLigacoes, total, segundos, total / segundos);
+    for (int i = 0; i < numLigacoes; i++) {
+        close(ligacoes[i].fd);
+        free(ligacoes[i].buffer);
+    }
+    free(ligacoes);
+    free(eventos);
+    return 0;
+}
@@ -0,0 +1,110 @@
+/**
+ * Client of the server of the vaccination system that sends the commands
+ * of its standard input to the socket of the server and prints the
+ * answers, like running the program on the same input without the server.
+ * 
+ * The commands are sent in a thread of their own while the answers are
+ * read, so a long input never waits for its answers to be read.
+ * @file: cliente.c
+ * @author: ist1114613 (João Tamagnini)
+ */
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/// Size of the buffers of the client, in bytes.
+#define TAM_BUFFER (1 << 16)
+
+/**
+ * @brief Connects to the socket of the server.
+ * 
+ * @param caminho Path of the socket.
+ * 
+ * @return The file descriptor of the connection, or -1 on failure.
+ */
+static int liga(const char *caminho) {
+    struct sockaddr_un endereco;
+    if (strlen(caminho) >= sizeof(endereco.sun_path)) return -1;
+    memset(&endereco, 0, sizeof(endereco));
+    endereco.sun_family = AF_UNIX;
+    strcpy(endereco.sun_path, caminho);
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    if (connect(fd, (struct sockaddr *)&endereco, sizeof(endereco)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * @brief Writes bytes to a file descriptor, retrying until all of them
+ * are written.
+ * 
+ * @param fd File descriptor.
+ * @param bytes Bytes to write.
+ * @param tamanho Number of bytes.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+static int escreve_tudo(int fd, const char *bytes, ssize_t tamanho) {
+    while (tamanho > 0) {
+        ssize_t escritos = write(fd, bytes, tamanho);
+        if (escritos <= 0) return 0;
+        bytes += escritos;
+        tamanho -= escritos;
+    }
+    return 1;
+}
+
+/**
+ * @brief Thread that sends the standard input to the server, and then
+ * tells it that the input ended.
+ * 
+ * @param argumento Pointer to the file descriptor of the connection.
+ * 
+ * @return NULL.
+ */
+static void *envia(void *argumento) {
+    int fd = *(int *)argumento;
+    char buffer[TAM_BUFFER];
+    ssize_t lidos;
+    while ((lidos = read(STDIN_FILENO, buffer, sizeof(buffer))) > 0 &&
+           escreve_tudo(fd, buffer, lidos)) {
+    }
+    shutdown(fd, SHUT_WR);
+    return NULL;
+}
+
+/**
+ * @brief Main function of the client.
+ * 
+ * @param argc Number of command-line arguments.
+ * @param argv Array of command-line argument strings.
+ * 
+ * @return 0 on success, 1 on invalid arguments or failure.
+ */
+int main(int argc, char *argv[]) {
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s socket < commands\n", argv[0]);
+        return 1;
+    }
+    int fd = liga(argv[1]);
+    pthread_t envio;
+    if (fd < 0 || pthread_create(&envio, NULL, envia, &fd) != 0) {
+        fprintf(stderr, "%s: cannot connect to %s\n", argv[0], argv[1]);
+        return 1;
+    }
+    char buffer[TAM_BUFFER];
+    ssize_t lidos;
+    int ok = 1;
+    while (ok && (lidos = read(fd, buffer, sizeof(buffer))) > 0) {
+        ok = escreve_tudo(STDOUT_FILENO, buffer, lidos);
+    }
+    pthread_join(envio, NULL);
+    close(fd);
+    return ok ? 0 : 1;
+}
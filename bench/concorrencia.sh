@@ -0,0 +1,79 @@
+#!/bin/sh
+# Concurrency check of the snapshots of the server of the vaccination system.
+#
+# Builds the project, the workload generator (bench/gerador.c) and the
+# client (bench/cliente.c), starts the server (--socket) with -F threads
+# and loads -i inoculations into it. Then, for each of -n rounds, -L
+# clients list all the inoculations ("u" with no name) while another
+# creates and removes a batch and saves a snapshot ("g"), so the snapshot
+# is taken while the slot of the removed batch is kept for the listings.
+# After each round, the snapshot is loaded (--snapshot) and must list the
+# same batches as the server, and create the same batch after them.
+#
+# Usage: bench/concorrencia.sh [-i inoculations] [-n rounds] [-L listing clients]
+#                              [-F server threads] [-w work directory]
+# CC and CFLAGS choose the compiler (cc -O2 by default).
+
+set -eu
+
+RAIZ=$(cd "$(dirname "$0")/.." && pwd)
+
+INOCULACOES=300000
+RONDAS=20
+LEITORES=3
+FIOS=4
+TRABALHO=${TMPDIR:-/tmp}/concorrencia-vacinas.$$
+while getopts "i:n:L:F:w:" opcao; do
+    case $opcao in
+        i) INOCULACOES=$OPTARG ;;
+        n) RONDAS=$OPTARG ;;
+        L) LEITORES=$OPTARG ;;
+        F) FIOS=$OPTARG ;;
+        w) TRABALHO=$OPTARG ;;
+        *) sed -n '/^# Usage/,/^# CC/p' "$0" >&2; exit 1 ;;
+    esac
+done
+
+mkdir -p "$TRABALHO"
+trap '[ -n "${SERVIDOR:-}" ] && kill "$SERVIDOR" 2>/dev/null; rm -rf "$TRABALHO"' EXIT
+CC=${CC:-cc}
+CFLAGS=${CFLAGS:--O2}
+# shellcheck disable=SC2086
+$CC $CFLAGS -pthread -o "$TRABALHO/project" "$RAIZ"/*.c
+# shellcheck disable=SC2086
+$CC $CFLAGS -o "$TRABALHO/gerador" "$RAIZ/bench/gerador.c"
+# shellcheck disable=SC2086
+$CC $CFLAGS -pthread -o "$TRABALHO/cliente" "$RAIZ/bench/cliente.c"
+
+"$TRABALHO/gerador" -f a -i "$INOCULACOES" -b 100 > "$TRABALHO/base.txt"
+"$TRABALHO/project" --socket "$TRABALHO/socket" --threads "$FIOS" > /dev/null &
+SERVIDOR=$!
+while [ ! -S "$TRABALHO/socket" ]; do sleep 0.05; done
+"$TRABALHO/cliente" "$TRABALHO/socket" < "$TRABALHO/base.txt" > /dev/null
+
+falhas=0
+for ronda in $(seq 1 "$RONDAS"); do
+    leitores=
+    for leitor in $(seq 1 "$LEITORES"); do
+        printf 'u\nu\nu\nu\nu\n' | "$TRABALHO/cliente" "$TRABALHO/socket" > /dev/null &
+        leitores="$leitores $!"
+    done
+    sleep 0.05
+    printf 'c F0%06X 31-12-2099 5 Ronda\nr F0%06X\ng %s\n' "$ronda" "$ronda" \
+           "$TRABALHO/snapshot" | "$TRABALHO/cliente" "$TRABALHO/socket" > /dev/null
+    # shellcheck disable=SC2086
+    wait $leitores
+
+    # The next batch reuses a free slot, also the one of the batch removed above.
+    comandos=$(printf 'c F1%06X 31-12-2099 5 Nova\nl\n' "$ronda")
+    echo "$comandos" | "$TRABALHO/cliente" "$TRABALHO/socket" > "$TRABALHO/servidor.txt"
+    if ! echo "$comandos" | "$TRABALHO/project" --snapshot "$TRABALHO/snapshot" \
+            > "$TRABALHO/snapshot.txt" 2>&1 ||
+       ! cmp -s "$TRABALHO/servidor.txt" "$TRABALHO/snapshot.txt"; then
+        echo "round $ronda: the snapshot does not match the server" >&2
+        diff "$TRABALHO/servidor.txt" "$TRABALHO/snapshot.txt" | head -n 5 >&2
+        falhas=$((falhas + 1))
+    fi
+done
+echo "$RONDAS rounds, $falhas failed"
+[ "$falhas" -eq 0 ]
@@ -0,0 +1,313 @@
+#!/bin/sh
+# End-to-end benchmark of the vaccination system.
+#
+# Builds the project and the workload generator (bench/gerador.c) with the
+# C compiler, then for each scale (number of inoculations) times:
+#   a        the batches and all the inoculations, with the date advancing;
+#   u, l, d  the same, followed by queries of that command only, so the
+#            cost per query is the difference to "a" over the number of
+#            queries (one per inoculation, or one per 100 for "l", which
+#            lists whole batches);
+#   mistura  a mix of a/u/d/l with the ratios of -r;
+#   listagem the same as "a", followed by -U listings of all the
+#            inoculations ("u" with no name), formatted by each number of
+#            threads of -L, so the cost per listing is the difference to
+#            "a" over -U;
+#   pipeline the "a" phase with --pipeline, which overlaps reading the
+#            commands and writing their answers with running them;
+#   rajadas  the "a" phase sent through a pipe in bursts of -R commands,
+#            with a pause of -P seconds after each, like a source that
+#            reads them in bursts, without and with --pipeline
+#            ("rajadas:pipeline"). The pipeline reads ahead up to its
+#            blocks of commands, much more than a pipe holds, so the
+#            source pauses while the commands of its burst still run;
+#   journal  the "a" phase with a journal under each sync policy (only
+#            at the scales up to -J, since syncing every record is slow);
+#   lotes    10000 inoculations over each number of batches of -B,
+#            followed by queries of "c", "r" or "v" (one per batch, up to
+#            10000), on a line of their own with the number of batches as
+#            the scale, to show how their cost grows with it;
+#   memoria  the "a" phase at each scale of -M, followed by "m", on lines
+#            of their own with the bytes reserved and used by the data
+#            structures (the total of "m") in place of the seconds, and
+#            the bytes per inoculation in place of the microseconds;
+#   servidor -T inoculations sent to the server (--socket) by the load-test
+#            client (bench/carga.c), split by each number of connections
+#            of -C, for a server with each number of threads of -F, on a
+#            line of their own with -T as the scale.
+#
+# The report is a TSV file with one line per scale and scenario, and two
+# reports (e.g. before and after a change) are compared with:
+#   bench/corre.sh compara antes.tsv depois.tsv
+#
+# Usage: bench/corre.sh [-e "1000 100000 1000000"] [-r a:u:d:l] [-q quoted%]
+#                       [-b batches] [-n repetitions] [-J max journal scale]
+#                       [-L "1 2 4"] [-U listings] [-B "1000 10000 100000"]
+#                       [-M "10000000"] [-R burst] [-P pause]
+#                       [-C "1 16 256"] [-F "1 4 16"] [-T server commands]
+#                       [-o report.tsv] [-w work directory]
+# CC and CFLAGS choose the compiler (cc -O2 by default).
+
+set -eu
+
+RAIZ=$(cd "$(dirname "$0")/.." && pwd)
+
+# Prints the average and the ratio of each scenario present in both reports.
+compara() {
+    awk -F '\t' '
+        /^#/ || $1 == "escala" { next }
+        NR == FNR { antes[$1 "\t" $2] = $6; next }
+        ($1 "\t" $2) in antes {
+            printf "%-10s %-22s %12.3f %12.3f %8.2fx\n", $1, $2,
+                   antes[$1 "\t" $2], $6, ($6 > 0 ? antes[$1 "\t" $2] / $6 : 0)
+        }
+    ' "$1" "$2" | {
+        printf "%-10s %-22s %12s %12s %9s\n" escala cenario "us/cmd antes" "us/cmd depois" speedup
+        cat
+    }
+}
+
+if [ "${1:-}" = compara ]; then
+    [ $# -eq 3 ] || { echo "usage: $0 compara <before.tsv> <after.tsv>" >&2; exit 1; }
+    compara "$2" "$3"
+    exit 0
+fi
+
+ESCALAS="1000 100000 1000000"
+RATIOS=70:15:5:10
+ASPAS=20
+LOTES=1000
+REPETICOES=1
+JOURNAL_MAXIMO=100000
+CONEXOES="1 16 256"
+FIOS=1
+FORMATADORES="1 2 4"
+LISTAGENS=5
+LOTES_VARRIDOS="1000 10000 100000"
+ESCALAS_MEMORIA=10000000
+RAJADA=20000
+PAUSA=0.02
+COMANDOS_SERVIDOR=200000
+RELATORIO=bench-$(date +%Y%m%d-%H%M%S).tsv
+TRABALHO=${TMPDIR:-/tmp}/bench-vacinas.$$
+while getopts "e:r:q:b:n:J:L:U:B:M:R:P:C:F:T:o:w:" opcao; do
+    case $opcao in
+        e) ESCALAS=$OPTARG ;;
+        r) RATIOS=$OPTARG ;;
+        q) ASPAS=$OPTARG ;;
+        b) LOTES=$OPTARG ;;
+        n) REPETICOES=$OPTARG ;;
+        J) JOURNAL_MAXIMO=$OPTARG ;;
+        L) FORMATADORES=$OPTARG ;;
+        U) LISTAGENS=$OPTARG ;;
+        B) LOTES_VARRIDOS=$OPTARG ;;
+        M) ESCALAS_MEMORIA=$OPTARG ;;
+        R) RAJADA=$OPTARG ;;
+        P) PAUSA=$OPTARG ;;
+        C) CONEXOES=$OPTARG ;;
+        F) FIOS=$OPTARG ;;
+        T) COMANDOS_SERVIDOR=$OPTARG ;;
+        o) RELATORIO=$OPTARG ;;
+        w) TRABALHO=$OPTARG ;;
+        *) sed -n '/^# Usage/,/^# CC/p' "$0" >&2; exit 1 ;;
+    esac
+done
+
+mkdir -p "$TRABALHO"
+trap '[ -n "${SERVIDOR:-}" ] && kill "$SERVIDOR" 2>/dev/null; rm -rf "$TRABALHO"' EXIT
+CC=${CC:-cc}
+CFLAGS=${CFLAGS:--O2}
+# shellcheck disable=SC2086
+$CC $CFLAGS -pthread -o "$TRABALHO/project" "$RAIZ"/*.c
+# shellcheck disable=SC2086
+$CC $CFLAGS -o "$TRABALHO/gerador" "$RAIZ/bench/gerador.c"
+# shellcheck disable=SC2086
+$CC $CFLAGS -o "$TRABALHO/carga" "$RAIZ/bench/carga.c"
+
+# Prints the best time, in seconds, of running the project on a workload.
+cronometra() {
+    entrada=$1
+    shift
+    melhor=
+    i=0
+    while [ "$i" -lt "$REPETICOES" ]; do
+        rm -f "$TRABALHO/journal"
+        inicio=$(date +%s.%N)
+        "$TRABALHO/project" "$@" < "$entrada" > /dev/null
+        fim=$(date +%s.%N)
+        melhor=$(awk -v a="$inicio" -v b="$fim" -v m="$melhor" \
+            'BEGIN { t = b - a; if (m != "" && m < t) t = m; printf "%.6f", t }')
+        i=$((i + 1))
+    done
+    echo "$melhor"
+}
+
+# Prints the best time, in seconds, of running the project on the pieces
+# of a workload split by split(1), sent through a pipe one after the
+# other with a pause after each.
+cronometra_rajadas() {
+    pedacos=$1
+    shift
+    melhor=
+    i=0
+    while [ "$i" -lt "$REPETICOES" ]; do
+        inicio=$(date +%s.%N)
+        for pedaco in "$pedacos".*; do
+            cat "$pedaco"
+            sleep "$PAUSA"
+        done | "$TRABALHO/project" "$@" > /dev/null
+        fim=$(date +%s.%N)
+        melhor=$(awk -v a="$inicio" -v b="$fim" -v m="$melhor" \
+            'BEGIN { t = b - a; if (m != "" && m < t) t = m; printf "%.6f", t }')
+        i=$((i + 1))
+    done
+    echo "$melhor"
+}
+
+# Appends a line to the report and prints it.
+regista() {
+    # escala cenario comandos segundos
+    awk -v OFS='\t' -v e="$1" -v c="$2" -v n="$3" -v s="$4" 'BEGIN {
+        print e, c, n, s, (s > 0 ? sprintf("%.0f", n / s) : 0),
+              (n > 0 ? sprintf("%.3f", s * 1e6 / n) : 0)
+    }' | tee -a "$RELATORIO"
+}
+
+# Appends a line of memory to the report and prints it.
+regista_memoria() {
+    # escala cenario bytes
+    awk -v OFS='\t' -v e="$1" -v c="$2" -v b="$3" 'BEGIN {
+        print e, c, e, b, 0, sprintf("%.3f", b / e)
+    }' | tee -a "$RELATORIO"
+}
+
+# Prints the bytes reserved and used by the data structures after a
+# workload, from the total of "m".
+mede_memoria() {
+    { sed '/^q$/d' "$1"; echo m; } | "$TRABALHO/project" | tail -n 1 | awk '{ print $2, $3 }'
+}
+
+{
+    echo "# revision $(git -C "$RAIZ" rev-parse --short HEAD 2>/dev/null || echo unknown)," \
+         "$(uname -srm), $(date '+%Y-%m-%d %H:%M:%S'), $CC $CFLAGS," \
+         "ratios $RATIOS, quoted $ASPAS%, batches $LOTES, best of $REPETICOES"
+    printf 'escala\tcenario\tcomandos\tsegundos\tcmd_por_s\tus_por_cmd\n'
+} | tee "$RELATORIO"
+
+for escala in $ESCALAS; do
+    utentes=$((escala / 10 > 100 ? escala / 10 : 100))
+    base="-i $escala -b $LOTES -n $utentes -v 10 -q $ASPAS"
+
+    # shellcheck disable=SC2086
+    "$TRABALHO/gerador" -f a $base > "$TRABALHO/a.txt"
+    comandosA=$(wc -l < "$TRABALHO/a.txt")
+    tempoA=$(cronometra "$TRABALHO/a.txt")
+    regista "$escala" a "$comandosA" "$tempoA"
+
+    # The queries are timed on top of the inoculations, which are subtracted.
+    for fase in u l d; do
+        consultas=$escala
+        [ "$fase" = l ] && consultas=$((escala / 100 > 100 ? escala / 100 : 100))
+        # shellcheck disable=SC2086
+        "$TRABALHO/gerador" -f $fase $base -c "$consultas" > "$TRABALHO/$fase.txt"
+        tempo=$(cronometra "$TRABALHO/$fase.txt")
+        regista "$escala" "$fase" "$consultas" \
+            "$(awk -v a="$tempoA" -v b="$tempo" 'BEGIN { printf "%.6f", (b > a ? b - a : 0) }')"
+        rm -f "$TRABALHO/$fase.txt"
+    done
+
+    # shellcheck disable=SC2086
+    "$TRABALHO/gerador" -f mistura -r "$RATIOS" $base > "$TRABALHO/mistura.txt"
+    regista "$escala" mistura "$(wc -l < "$TRABALHO/mistura.txt")" \
+        "$(cronometra "$TRABALHO/mistura.txt")"
+    rm -f "$TRABALHO/mistura.txt"
+
+    regista "$escala" pipeline "$comandosA" "$(cronometra "$TRABALHO/a.txt" --pipeline)"
+    split -l "$RAJADA" "$TRABALHO/a.txt" "$TRABALHO/rajada."
+    regista "$escala" rajadas "$comandosA" "$(cronometra_rajadas "$TRABALHO/rajada")"
+    regista "$escala" rajadas:pipeline "$comandosA" \
+        "$(cronometra_rajadas "$TRABALHO/rajada" --pipeline)"
+    rm -f "$TRABALHO"/rajada.*
+
+    # The listings are timed on top of the inoculations, like the queries.
+    { sed '/^q$/d' "$TRABALHO/a.txt"; yes u | head -n "$LISTAGENS"; echo q; } \
+        > "$TRABALHO/listagem.txt"
+    for formatadores in $FORMATADORES; do
+        tempo=$(cronometra "$TRABALHO/listagem.txt" --list-threads "$formatadores")
+        regista "$escala" "listagem:${formatadores}t" "$LISTAGENS" \
+            "$(awk -v a="$tempoA" -v b="$tempo" 'BEGIN { printf "%.6f", (b > a ? b - a : 0) }')"
+    done
+    rm -f "$TRABALHO/listagem.txt"
+
+    if [ "$escala" -le "$JOURNAL_MAXIMO" ]; then
+        for politica in "--sync-every 1" "--sync-every 1000" "--sync-ms 10" "--sync-every 0"; do
+            # shellcheck disable=SC2086
+            tempo=$(cronometra "$TRABALHO/a.txt" --journal "$TRABALHO/journal" $politica)
+            regista "$escala" "journal$(echo "$politica" | tr -d ' ' | sed 's/^--sync-/:/')" \
+                "$comandosA" "$tempo"
+        done
+    fi
+    rm -f "$TRABALHO/a.txt"
+done
+
+# The memory is measured on the inoculations alone, with the same users
+# as the scales above.
+for escala in $ESCALAS_MEMORIA; do
+    utentes=$((escala / 10 > 100 ? escala / 10 : 100))
+    "$TRABALHO/gerador" -f a -i "$escala" -b "$LOTES" -n "$utentes" -v 10 -q "$ASPAS" \
+        > "$TRABALHO/a.txt"
+    # shellcheck disable=SC2046
+    set -- $(mede_memoria "$TRABALHO/a.txt")
+    regista_memoria "$escala" memoria:reservada "$1"
+    regista_memoria "$escala" memoria:usada "$2"
+    rm -f "$TRABALHO/a.txt"
+done
+
+# The batch commands are timed on top of the same inoculations spread
+# over more and more batches, which are subtracted like for the queries.
+for lotes in $LOTES_VARRIDOS; do
+    base="-i 10000 -b $lotes -n 1000 -v 10 -q $ASPAS"
+    # shellcheck disable=SC2086
+    "$TRABALHO/gerador" -f a $base > "$TRABALHO/a.txt"
+    tempoA=$(cronometra "$TRABALHO/a.txt")
+    consultas=$((lotes < 10000 ? lotes : 10000))
+    for fase in c r v; do
+        # shellcheck disable=SC2086
+        "$TRABALHO/gerador" -f $fase $base -c "$consultas" > "$TRABALHO/$fase.txt"
+        tempo=$(cronometra "$TRABALHO/$fase.txt")
+        regista "$lotes" "lotes:$fase" "$consultas" \
+            "$(awk -v a="$tempoA" -v b="$tempo" 'BEGIN { printf "%.6f", (b > a ? b - a : 0) }')"
+        rm -f "$TRABALHO/$fase.txt"
+    done
+    rm -f "$TRABALHO/a.txt"
+done
+
+# The server gets the same number of inoculations from each number of
+# connections, and the best run of each is kept. The inoculations are
+# spread over 64 vaccines, so that the threads vaccinate apart.
+for fios in $FIOS; do
+    [ -n "$CONEXOES" ] || break
+    rm -f "$TRABALHO/socket"
+    "$TRABALHO/project" --socket "$TRABALHO/socket" --threads "$fios" > /dev/null &
+    SERVIDOR=$!
+    while [ ! -S "$TRABALHO/socket" ]; do sleep 0.05; done
+    for conexoes in $CONEXOES; do
+        porConexao=$((COMANDOS_SERVIDOR / conexoes > 1 ? COMANDOS_SERVIDOR / conexoes : 1))
+        melhor=
+        i=0
+        while [ "$i" -lt "$REPETICOES" ]; do
+            tempo=$("$TRABALHO/carga" -s "$TRABALHO/socket" -c "$conexoes" -n "$porConexao" \
+                        -v 64 | cut -d ' ' -f 3)
+            melhor=$(awk -v t="$tempo" -v m="$melhor" \
+                'BEGIN { if (m != "" && m < t) t = m; printf "%.6f", t }')
+            i=$((i + 1))
+        done
+        regista "$COMANDOS_SERVIDOR" "servidor:${fios}t:${conexoes}c" \
+            $((porConexao * conexoes)) "$melhor"
+    done
+    kill "$SERVIDOR"
+    wait "$SERVIDOR" || true
+    SERVIDOR=
+done
+
+echo "report written to $RELATORIO" >&2
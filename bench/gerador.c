@@ -0,0 +1,261 @@
+/**
+ * Synthetic workload generator for the vaccination system.
+ * 
+ * Writes to stdout a stream of commands with a setup of vaccine batches,
+ * inoculations of many users (some with quoted names of several words),
+ * date advances with "t" and a mix of listings and deletions, so that
+ * the throughput and latency of each command can be measured. The
+ * batches can also be created, removed or given new dates after the
+ * inoculations, to time those commands as the number of batches grows.
+ * @file: gerador.c
+ * @author: ist1114613 (João Tamagnini)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/// Structure with the parameters of a workload.
+typedef struct {
+    long long numInoculacoes;
+    int numLotes, numUtentes, numVacinas;
+    long long numConsultas;
+    int pesoA, pesoU, pesoD, pesoL;
+    int percentagemAspas;
+    const char *fase;
+    unsigned long long semente;
+} Parametros;
+
+/**
+ * @brief Gets the next pseudo-random number (xorshift64*).
+ * 
+ * @param estado Pointer to the state of the generator.
+ * 
+ * @return The next number.
+ */
+static unsigned long long aleatorio(unsigned long long *estado) {
+    *estado ^= *estado >> 12;
+    *estado ^= *estado << 25;
+    *estado ^= *estado >> 27;
+    return *estado * 2685821657736338717ull;
+}
+
+/**
+ * @brief Checks if the name of a user is quoted and has several words,
+ * which happens for a percentage of the users.
+ * 
+ * @param p Pointer to the parameters of the workload.
+ * @param utente Number of the user.
+ * 
+ * @return 1 if the name is quoted, 0 otherwise.
+ */
+static int tem_aspas(const Parametros *p, long long utente) {
+    return (utente * 37) % 100 < p->percentagemAspas;
+}
+
+/**
+ * @brief Writes the name of a user.
+ * 
+ * @param p Pointer to the parameters of the workload.
+ * @param utente Number of the user.
+ */
+static void escreve_utente(const Parametros *p, long long utente) {
+    if (tem_aspas(p, utente)) {
+        printf("\"Utente %lld da Silva\"", utente);
+    } else {
+        printf("u%lld", utente);
+    }
+}
+
+/**
+ * @brief Writes the commands that create the batches. The batches
+ * expire years from now and have enough doses for the workload.
+ * 
+ * @param p Pointer to the parameters of the workload.
+ */
+static void escreve_lotes(const Parametros *p) {
+    long long doses = p->numInoculacoes / p->numLotes * 2 + 10;
+    if (doses > 2000000000) doses = 2000000000;
+    for (int i = 0; i < p->numLotes; i++) {
+        printf("c %08X %d-%d-%d %lld V%d\n", i, 1 + i % 28, 1 + i / 28 % 12,
+               2030 + i % 10, doses, i % p->numVacinas);
+    }
+}
+
+/**
+ * @brief Writes the inoculations. Each user gets each vaccine once a
+ * day, and the date advances when all of them were given, so no
+ * inoculation is refused as already vaccinated.
+ * 
+ * @param p Pointer to the parameters of the workload.
+ * @param numInoculacoes Number of inoculations to write.
+ * @param dia Pointer to the number of days after the first date.
+ */
+static void escreve_inoculacoes(const Parametros *p, long long numInoculacoes, int *dia) {
+    long long porDia = (long long)p->numUtentes * p->numVacinas;
+    for (long long i = 0; i < numInoculacoes; i++) {
+        if (i > 0 && i % porDia == 0) {
+            (*dia)++;
+            printf("t %d-%d-%d\n", 1 + *dia % 28, 1 + *dia / 28 % 12, 2025 + *dia / 336);
+        }
+        printf("a ");
+        escreve_utente(p, i % p->numUtentes);
+        printf(" V%lld\n", i / p->numUtentes % p->numVacinas);
+    }
+}
+
+/**
+ * @brief Gets a user whose name is a single word, starting at the given
+ * one, since "d" does not take quoted names.
+ * 
+ * @param p Pointer to the parameters of the workload.
+ * @param utente Number of the first user to try.
+ * 
+ * @return The number of the user.
+ */
+static long long utente_sem_aspas(const Parametros *p, long long utente) {
+    for (int i = 0; i < 100 && tem_aspas(p, utente); i++) {
+        utente = (utente + 1) % p->numUtentes;
+    }
+    return utente;
+}
+
+/**
+ * @brief Writes the queries of a phase, after the inoculations.
+ * 
+ * @param p Pointer to the parameters of the workload.
+ * @param comando Letter of the queries ('u', 'l', 'd', 'c', 'r' or 'v').
+ * @param estado Pointer to the state of the random generator.
+ * 
+ * @note "c" creates batches after those of the setup, "r" removes the
+ * batches of the setup in turn, and "v" gives random batches of the
+ * setup a new date.
+ */
+static void escreve_consultas(const Parametros *p, char comando, unsigned long long *estado) {
+    for (long long i = 0; i < p->numConsultas; i++) {
+        if (comando == 'c') {
+            printf("c %08llX 1-1-2040 10 V%lld\n", (unsigned long long)(p->numLotes + i),
+                   i % p->numVacinas);
+        } else if (comando == 'r') {
+            printf("r %08llX\n", (unsigned long long)(i % p->numLotes));
+        } else if (comando == 'v') {
+            unsigned long long dia = aleatorio(estado) % 3360;
+            printf("v %08llX %llu-%llu-%llu\n", aleatorio(estado) % p->numLotes, 1 + dia % 28,
+                   1 + dia / 28 % 12, 2030 + dia / 336);
+        } else if (comando == 'l') {
+            printf("l V%llu\n", aleatorio(estado) % p->numVacinas);
+        } else {
+            // Deletions go through distinct users, so most delete something.
+            long long utente = comando == 'd' ? utente_sem_aspas(p, i % p->numUtentes) :
+                               (long long)(aleatorio(estado) % p->numUtentes);
+            printf("%c ", comando);
+            escreve_utente(p, utente);
+            printf("\n");
+        }
+    }
+}
+
+/**
+ * @brief Writes a mix of inoculations, listings and deletions with the
+ * weights of the parameters, advancing the date now and then.
+ * 
+ * @param p Pointer to the parameters of the workload.
+ * @param estado Pointer to the state of the random generator.
+ * @param dia Pointer to the number of days after the first date.
+ */
+static void escreve_mistura(const Parametros *p, unsigned long long *estado, int *dia) {
+    int total = p->pesoA + p->pesoU + p->pesoD + p->pesoL;
+    long long numInoculacoes = 0;
+    while (numInoculacoes < p->numInoculacoes) {
+        int escolha = (int)(aleatorio(estado) % total);
+        long long utente = (long long)(aleatorio(estado) % p->numUtentes);
+        if (escolha < p->pesoA) {
+            printf("a ");
+            escreve_utente(p, utente);
+            printf(" V%llu\n", aleatorio(estado) % p->numVacinas);
+            if (++numInoculacoes % ((long long)p->numUtentes * p->numVacinas / 4 + 1) == 0) {
+                (*dia)++;
+                printf("t %d-%d-%d\n", 1 + *dia % 28, 1 + *dia / 28 % 12, 2025 + *dia / 336);
+            }
+        } else if (escolha < p->pesoA + p->pesoU) {
+            printf("u ");
+            escreve_utente(p, utente);
+            printf("\n");
+        } else if (escolha < p->pesoA + p->pesoU + p->pesoD) {
+            printf("d ");
+            escreve_utente(p, utente_sem_aspas(p, utente));
+            printf("\n");
+        } else {
+            printf("l V%llu\n", aleatorio(estado) % p->numVacinas);
+        }
+    }
+}
+
+/**
+ * @brief Prints how to use the generator.
+ * 
+ * @param programa Name of the program.
+ */
+static void uso(const char *programa) {
+    fprintf(stderr,
+        "usage: %s [-f mistura|a|u|l|d|c|r|v] [-i inoculations] [-b batches] [-n users]\n"
+        "          [-v vaccines] [-c queries] [-r a:u:d:l] [-q quoted%%] [-s seed]\n"
+        "  -f  phase: a mix of commands, or inoculations followed by queries\n"
+        "      of one command ('a' writes only the inoculations)\n", programa);
+}
+
+/**
+ * @brief Main function of the generator.
+ * 
+ * @param argc Number of command-line arguments.
+ * @param argv Array of command-line argument strings.
+ * 
+ * @return 0 on success, 1 on invalid arguments.
+ */
+int main(int argc, char *argv[]) {
+    Parametros p = { 100000, 100, 10000, 10, 1000, 70, 15, 5, 10, 20, "mistura", 1 };
+    int opcao;
+    while ((opcao = getopt(argc, argv, "f:i:b:n:v:c:r:q:s:")) != -1) {
+        switch (opcao) {
+            case 'f': p.fase = optarg; break;
+            case 'i': p.numInoculacoes = atoll(optarg); break;
+            case 'b': p.numLotes = atoi(optarg); break;
+            case 'n': p.numUtentes = atoi(optarg); break;
+            case 'v': p.numVacinas = atoi(optarg); break;
+            case 'c': p.numConsultas = atoll(optarg); break;
+            case 'q': p.percentagemAspas = atoi(optarg); break;
+            case 's': p.semente = strtoull(optarg, NULL, 10); break;
+            case 'r':
+                if (sscanf(optarg, "%d:%d:%d:%d", &p.pesoA, &p.pesoU, &p.pesoD, &p.pesoL) != 4) {
+                    uso(argv[0]);
+                    return 1;
+                }
+                break;
+            default: uso(argv[0]); return 1;
+        }
+    }
+    if (p.numLotes < 1 || p.numUtentes < 1 || p.numVacinas < 1 || p.numInoculacoes < 0 ||
+        p.pesoA < 0 || p.pesoU < 0 || p.pesoD < 0 || p.pesoL < 0 ||
+        p.pesoA + p.pesoU + p.pesoD + p.pesoL == 0 ||
+        (p.pesoA == 0 && strcmp(p.fase, "mistura") == 0) ||
+        (strcmp(p.fase, "mistura") != 0 && strlen(p.fase) != 1) ||
+        strchr("mauldcrv", p.fase[0]) == NULL) {
+        uso(argv[0]);
+        return 1;
+    }
+
+    // A large stdout buffer, since the workloads have millions of lines.
+    static char buffer[1 << 20];
+    setvbuf(stdout, buffer, _IOFBF, sizeof(buffer));
+    unsigned long long estado = p.semente * 0x9E3779B97F4A7C15ull + 1;
+    int dia = 0;
+    escreve_lotes(&p);
+    if (strcmp(p.fase, "mistura") == 0) {
+        escreve_mistura(&p, &estado, &dia);
+    } else {
+        escreve_inoculacoes(&p, p.numInoculacoes, &dia);
+        if (p.fase[0] != 'a') escreve_consultas(&p, p.fase[0], &estado);
+    }
+    printf("q\n");
+    return 0;
+}
@@ -0,0 +1,81 @@
+#!/bin/sh
+# Regression check of the limits of the batch numbers and of the vaccine
+# names of the vaccination system.
+#
+# Builds the project and creates a batch whose number is exactly MAX_LOTE
+# characters long, of a vaccine whose name is exactly MAX_NOME characters
+# long, as read from constants.h. Vaccinates with it, lists it ("l" and
+# "u") and saves and loads it in a snapshot, and checks that the number
+# and the name are printed whole and nothing after them. A number or a
+# name one character longer must be rejected.
+#
+# Usage: bench/limites.sh [-w work directory]
+# CC and CFLAGS choose the compiler (cc -O2 by default).
+
+set -eu
+
+RAIZ=$(cd "$(dirname "$0")/.." && pwd)
+
+TRABALHO=${TMPDIR:-/tmp}/limites-vacinas.$$
+while getopts "w:" opcao; do
+    case $opcao in
+        w) TRABALHO=$OPTARG ;;
+        *) sed -n '/^# Usage/,/^# CC/p' "$0" >&2; exit 1 ;;
+    esac
+done
+
+mkdir -p "$TRABALHO"
+trap 'rm -rf "$TRABALHO"' EXIT
+CC=${CC:-cc}
+CFLAGS=${CFLAGS:--O2}
+# shellcheck disable=SC2086
+$CC $CFLAGS -pthread -o "$TRABALHO/project" "$RAIZ"/*.c
+
+# Prints a text of a character repeated a number of times.
+repete() {
+    printf "%$2s" '' | tr ' ' "$1"
+}
+
+maxLote=$(sed -n 's/^#define MAX_LOTE \([0-9]*\)$/\1/p' "$RAIZ/constants.h")
+maxNome=$(sed -n 's/^#define MAX_NOME \([0-9]*\)$/\1/p' "$RAIZ/constants.h")
+lote=$(repete A "$maxLote")
+nome=$(repete N "$maxNome")
+
+falhas=0
+# Compares the output of the project on some commands with the expected one.
+verifica() {
+    caso=$1
+    comandos=$2
+    esperado=$3
+    shift 3
+    printf '%s\n' "$comandos" | "$TRABALHO/project" "$@" > "$TRABALHO/obtido.txt" 2>&1 || true
+    printf '%s\n' "$esperado" > "$TRABALHO/esperado.txt"
+    if ! cmp -s "$TRABALHO/esperado.txt" "$TRABALHO/obtido.txt"; then
+        echo "$caso: unexpected output" >&2
+        diff "$TRABALHO/esperado.txt" "$TRABALHO/obtido.txt" | head -n 5 | cat -v >&2
+        falhas=$((falhas + 1))
+    fi
+}
+
+verifica "longest batch and name" \
+"c $lote 1-1-2026 5 $nome
+a x $nome
+l
+u
+g $TRABALHO/snapshot" \
+"$lote
+$lote
+$nome $lote 01-01-2026 4 1
+x $lote 01-01-2025"
+
+verifica "longest batch and name from a snapshot" \
+"l
+u" \
+"$nome $lote 01-01-2026 4 1
+x $lote 01-01-2025" --snapshot "$TRABALHO/snapshot"
+
+verifica "batch too long" "c ${lote}A 1-1-2026 5 P" "invalid batch"
+verifica "name too long" "c 1 1-1-2026 5 ${nome}N" "invalid name"
+
+echo "4 cases, $falhas failed"
+[ "$falhas" -eq 0 ]
@@ -1,376 +1,554 @@
-/**
- * Implementation of the commands for the vaccination system.
- * @file: commands.c
- * @author: ist1114613 (João Tamagnini)
- */
-#include "headers.h"
-
-/**
- * @brief Creates a new vaccine batch.
- * 
- * @param sistema Pointer to the vaccination system structure.
- * @param current_language Language for error messages.
- * 
- * @note Possible Errors:
- * - too many vaccines 
- * - invalid name
- * - duplicate batch number
- * - invalid batch
- * - invalid date
- * - invalid quantity
- *
- * @return On success prints the batch number, otherwise prints an error message.
-*/
-void comandoc(Sistema *sistema,char *current_language) {
-    // Check if the system has reached the maximum number of batches.
-    if (!valid_amount_of_batches(sistema,current_language)) return;
-
-    // Reading the input line and extracting parameters.
-    Lote novoLote;
-    char nome[MAX_INSTRUCAO];
-    char lote[MAX_INSTRUCAO];
-    int dia, mes, ano, quantidade;
-    char linha[MAX_INSTRUCAO];
-    fgets(linha, sizeof(linha), stdin);
-    sscanf(linha, "%s %d-%d-%d %d %s", lote, &dia, &mes, &ano, &quantidade, nome);
-
-    
-    // Error checks.
-    if (valid_name(nome,current_language) == 0) return;
-    if (duplicate_batch(sistema, lote,current_language) == 0) return;
-    if (islower(nome[0])) {
-        printf("vaccine name cannot begin with a lowercase letter\n");
-         return; 
-     }
-    if (valid_batch(current_language, lote) == 0) return;
-    if (!datavalida(dia, mes, ano, sistema,current_language)) return;
-    if (valid_quantity(quantidade,current_language) == 0) return;
-
-    // Assigning values to the new batch.
-    strcpy(novoLote.lote, lote);
-    novoLote.dia = dia;
-    novoLote.mes = mes;
-    novoLote.ano = ano;
-    novoLote.quantidade = quantidade;
-    strcpy(novoLote.nome, nome);
-    novoLote.numInoculacoes = 0;
-    sistema->lotes[sistema->numLotes++] = novoLote;
-    printf("%s\n", lote);
-}
-
-/**
- * @brief Lists all vaccine batches or those matching specific names.
- * 
- * @param sistema Pointer to the vaccination system structure.
- * @param current_language Language for error messages.
- * 
- * @note If a batch name is provided and it is not found, the following error 
- * message is printed <vaccine_name>: no such vaccine.
- * 
- * @return Prints the details of the batches or an error message 
- * if a batch name is provided and it is not found.
-*/
-void comandol(Sistema *sistema,char *current_language) {
-    // Reading the input line and extracting batch names.
-    char linha[MAX_INSTRUCAO];
-    fgets(linha, sizeof(linha), stdin);
-    linha[strcspn(linha, "\n")] = 0;
-    char *nomes[MAX_LOTES];
-    int numNomes = 0;
-    char *token = strtok(linha, " ");
-    while (token != NULL) {
-        nomes[numNomes++] = token;
-        token = strtok(NULL, " ");
-    }
-    sortLotesPorData(sistema);
-
-    /* If batch names are provided, check if the provided names exist in the 
-    system,if they do not exist print an error message.*/
-    // Otherwise, list all batches. 
-    if (numNomes>0) {
-        for (int i = 0; i < numNomes; i++) {
-            int existe = 0;
-            for (int j = 0; j < sistema->numLotes; j++) {
-                if (strcmp(sistema->lotes[j].nome, nomes[i]) == 0) {
-                    printf("%s %s %02d-%02d-%d %d %d\n",sistema->lotes[j].nome,sistema->lotes[j].lote,
-                           sistema->lotes[j].dia,sistema->lotes[j].mes,sistema->lotes[j].ano,
-                           sistema->lotes[j].quantidade,sistema->lotes[j].numInoculacoes);
-                existe = 1;}
-            }if (!existe) {
-                printf("%s: ", nomes[i]);
-                Error_non_existent_vaccine(current_language);
-            }
-        }
-    } else {
-        all_batches(sistema);
-    }
-}
-
-/**
- * @brief Vaccinates a user with a specific vaccine batch
- * with the oldest vaccine in the systems as long as that
- * vaccine is available and if it is not expired.
- * 
- * @param sistema Pointer to the vaccination system structure.
- * @param current_language Language for error messages.
- * 
- * @note Possible Errors:
- * - no stock
- * - already vaccinated
- * - exceeded memory capacity
- *
- * @return On success prints the batch number, otherwise prints an error message.
- */
-void comandoa(Sistema *sistema, char *current_language) {
-    // Extracting user and vaccine names from the input line.
-    char linha[MAX_INSTRUCAO];
-    if (!fgets(linha, sizeof(linha), stdin)){
-        return;
-    }
-    linha[strcspn(linha, "\n")] = '\0';
-    char nomeUtente[MAX_INSTRUCAO];
-    char nomeVacina[MAX_NOME];
-    extrai_parametros_a(linha, nomeUtente, nomeVacina);
-
-    // Sort the batches by date.
-    sortLotesPorData(sistema); 
-
-    /* Looking for the vaccine batch in the system
-    if no valid vaccine is found or if the user has been
-    vaccinated by a vaccine with the same name on the 
-    same date print an error.*/
-    Lote *loteSelecionado = NULL;
-    search_for_vaccine(sistema, nomeVacina, &loteSelecionado, current_language);
-    if (loteSelecionado == NULL) {
-        return;
-    }
-    if (!already_vaccinated(sistema, nomeUtente, current_language, loteSelecionado)) {
-        return;
-    }
-    /* Check if the system has reached the maximum number of inoculations
-    and if it has increase the memory allocated towards inoculations*/
-    if (sistema->numInoculacoes >= sistema->capacidadeInoculacoes) {
-        if (!expandeInoculacoes(sistema,current_language)) {
-            return; 
-        }
-    }
-    // Vaccination process.
-    inocullation(loteSelecionado, sistema, nomeUtente, current_language);
-}
-
-/**
- * @brief Deletes a vaccine batch or sets its quantity to zero.
- * 
- * @param sistema Pointer to the vaccination system structure.
- * @param current_language Language for error messages.
- * 
- * @note If the batch is not found, an error message is printed
- * in the format <batch>: no such batch.
- * 
- * @return Prints the number of inoculations deleted or an error 
- * message if the batch is not found.
- */
-void comandor(Sistema *sistema,char *current_language) {
-    // Initialize variables and read batch from input.
-    char lote[MAX_INSTRUCAO];
-    scanf("%s", lote);
-    int found = 0;
-    int numInoculacoesV = 0;
-
-    /* Check if the batch exists in the system and count the number of 
-    inoculations and if said number is 0 delete the batch.*/
-    for (int i = 0; i < sistema->numLotes; i++) {
-        if (strcmp(sistema->lotes[i].lote, lote) == 0) {
-            found = 1;
-            for (int j = 0; j < sistema->numInoculacoes; j++) {
-                if (strcmp(sistema->inoculacoes[j].lote, lote) == 0) {
-                    numInoculacoesV++;
-                }
-            }
-            if (numInoculacoesV == 0) {
-                sistema->lotes[i] = sistema->lotes[--sistema->numLotes];
-            } else {
-                sistema->lotes[i].quantidade = 0;
-            }
-            printf("%d\n", numInoculacoesV);
-            break;
-        }
-    }
-
-    // If the batch was not found print the error message <batch>: no such batch.
-    if (!found) {
-        printf("%s: ",lote);
-        Error_non_existent_batch(current_language);
-    }
-}
-
-
-void comandov(Sistema *sistema){
-    char lote[MAX_LOTE];
-    int dia, mes, ano;
-    scanf("%s %d-%d-%d",lote, &dia, &mes, &ano);
-    int i;
-    int existe = 0;
-    for (i=0;i < sistema->numLotes;i++){
-        if (strcmp(sistema->lotes[i].lote,lote)==0){
-            existe= 1;
-            break;
-        }
-    }
-    if (!existe) {
-        printf("%s: no such batch\n",lote);
-        return;
-    }
-    if (dia < 1 || dia > 31 || mes < 1 || mes > 12 || ano < sistema->ano_atual ||
-        (ano == sistema->ano_atual && mes == sistema->mes_atual && sistema->dia_atual > dia) ||
-        (ano == sistema->ano_atual && sistema->mes_atual > mes)) {
-        printf("invalid date\n");     
-        return;
-    }
-
-    // Determine the number of days in the month.
-    int diasNoMes[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
-    
-    // Check for leap year, and adjust February's days accordingly.
-    if (ano % 4 == 0 && (ano % 100 != 0 || ano % 400 == 0)) {
-        diasNoMes[1] = 29; 
-    }
-
-    // Check if the day exceeds the number of days in the month.
-    if (dia > diasNoMes[mes - 1]) {
-        printf("invalid date\n");
-        return;
-    }
-    sistema->lotes[i].dia = dia;
-    sistema->lotes[i].mes = mes;   
-    sistema->lotes[i].ano = ano;
-    printf("%d\n",sistema->lotes[i].quantidade);
-    return;
-}
-/**
- * @brief Deletes inoculations from the system.
- * @details This function deletes inoculations based on the user name
- *  or user name and date or username,date and batch number.
- * 
- * @param sistema Pointer to the vaccination system structure.
- * @param current_language Language for error messages.
- * 
- * @note Possible Errors:
- * - <username>: no such user
- * - invalid date
- * - <batch>: no such batch
- *
- * @return Prints the number of inoculations deleted or an error message.
-*/
-void comandod(Sistema *sistema, char *current_language) {
-    // Initialize variables and read input line.
-    char linha[MAX_INSTRUCAO];
-    char nomeUtente[N_UTENTE];
-    int dia = -1, mes = -1, ano = -1;
-    int numArgs = 0;
-    char lote[MAX_LOTE] = "";
-
-    fgets(linha, sizeof(linha), stdin);
-    linha[strcspn(linha, "\n")] = 0;
-    numArgs = sscanf(linha, "%s %d-%d-%d %s", nomeUtente, &dia, &mes, &ano, lote);
-
-    // If no arguments are provided, return.
-    if (numArgs < 1) {
-        return;
-    }
-    // Check if the batch exists in the system.
-    if (numArgs == 5) {
-        if (!existing_batch(sistema, lote, current_language)) {
-            return;
-        }
-    }
-    // Check if the data is valid.
-    if (numArgs >= 4 && !datavalidaHistory(dia, mes, ano, sistema, current_language)) {
-        return;
-    }
-    /* Check if the user exists in the system and delete
-    inoculations based on the provided arguments.*/    
-    delete_inocullations(sistema, nomeUtente, current_language, dia, mes,
-         ano, lote, numArgs);
-}
-
-/**
- * @brief Lists all inoculations or those matching a specific user.
- * 
- * @param sistema Pointer to the vaccination system structure.
- * @param current_language Language for error messages.
- * 
- * @note If a user name is provided and it is not found, an error message 
- * is printed in the format <username>: no such user.
- * 
- * @return Prints the details of the inoculations or an error message
- *  if a user name is provided and it is not found.
- */
-void comandou(Sistema *sistema,char *current_language) {
-    // Initialize variables and read input line.
-    char linha[MAX_INSTRUCAO];
-    fgets(linha, sizeof(linha), stdin);
-    linha[strcspn(linha, "\n")] = 0;
-    // If no user name is provided, list all inoculations.
-    if (strlen(linha) == 0) {
-        all_inocullations(sistema);
-    } else {
-        // Extract user name from the input line.
-        char nomeUtente[MAX_INSTRUCAO];
-        if (linha[1] == '"') {
-            char *start = strchr(linha, '"');
-            char *end = strrchr(linha, '"');
-            if (start != NULL && end != NULL && start != end) {
-                strncpy(nomeUtente, start + 1, end-start-1);
-                nomeUtente[end-start-1] = '\0';
-            }
-        } else {
-            sscanf(linha, "%s", nomeUtente);
-        }
-        // Check if the user exists in the system and list their inoculations.
-        user_inocullations(sistema, nomeUtente, current_language);
-    }
-}
-
-/**
- * @brief Updates or gives the current date of the system.
- * 
- * @param sistema Pointer to the vaccination system structure.
- * @param current_language Language for error messages.
- * 
- * @note If the date is invalid, an error message is printed
- * with the message "invalid date".
- * 
- * @return Prints the updated date in the format dd-mm-yyyy.
- */
-void comandot(Sistema *sistema, char *current_language) {
-    // Initialize variables and read input line.
-    char data[MAX_DATA];
-
-    // If no date is provided, print the current date.
-    if (fgets(data, sizeof(data), stdin) == NULL || data[0] == '\n') {
-        printf("%02d-%02d-%d\n", sistema->dia_atual, sistema->mes_atual,
-             sistema->ano_atual);
-        return;
-    }
-    
-    // Extract day, month, and year from the input line.
-    int dia, mes, ano;
-
-    // Check if the input format is valid.
-    if (sscanf(data, "%d-%d-%d", &dia, &mes, &ano) != 3) {
-        return;
-    }
-    
-    // Check if the date is valid.
-    if (!datavalida(dia, mes, ano, sistema, current_language)){
-        return;
-    }
-    
-    // Update the system date and print it.
-    sistema->dia_atual = dia;
-    sistema->mes_atual = mes;
-    sistema->ano_atual = ano;
-    printf("%02d-%02d-%d\n", sistema->dia_atual, sistema->mes_atual, 
-        sistema->ano_atual);
-}
\ No newline at end of file
+/**
+ * Implementation of the commands for the vaccination system.
+ * @file: commands.c
+ * @author: ist1114613 (João Tamagnini)
+ */
+#include "headers.h"
+
+/**
+ * @brief Creates a new vaccine batch.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param linha Parameters of the command, which are split in place.
+ * @param saida Output where the results are written.
+ * @param current_language Language for error messages.
+ * 
+ * @note Possible Errors:
+ * - too many vaccines 
+ * - invalid name
+ * - duplicate batch number
+ * - invalid batch
+ * - invalid date
+ * - invalid quantity
+ *
+ * @return On success prints the batch number, otherwise prints an error message.
+*/
+void comandoc(Sistema *sistema, char *linha, Saida *saida, char *current_language) {
+    // Check if the system has reached the maximum number of batches.
+    if (!valid_amount_of_batches(sistema,saida, current_language)) return;
+
+    // Extracting the parameters from the input line.
+    Lote novoLote;
+    char *lote = proxima_palavra(&linha), *nome = NULL;
+    int dia = 0, mes = 0, ano = 0, quantidade = 0;
+    if (proxima_data(&linha, &dia, &mes, &ano) == 3 && proximo_inteiro(&linha, &quantidade)) {
+        nome = proxima_palavra(&linha);
+    }
+    if (lote == NULL) lote = "";
+    if (nome == NULL) nome = "";
+
+    // Error checks.
+    if (valid_name(nome,saida, current_language) == 0) return;
+    if (duplicate_batch(sistema, lote,saida, current_language) == 0) return;
+    if (islower(nome[0])) {
+        escreve_linha(saida, "vaccine name cannot begin with a lowercase letter");
+         return; 
+     }
+    if (valid_batch(saida, current_language, lote) == 0) return;
+    if (!datavalida(dia, mes, ano, sistema,saida, current_language)) return;
+    if (valid_quantity(quantidade,saida, current_language) == 0) return;
+
+    // Assigning values to the new batch.
+    strcpy(novoLote.lote, lote);
+    novoLote.data = empacota_data(dia, mes, ano);
+    novoLote.quantidade = quantidade;
+    strcpy(novoLote.nome, nome);
+    novoLote.numInoculacoes = 0;
+    novoLote.vacina = regista_vacina(sistema, nome);
+    novoLote.posHeap = -1;
+    novoLote.slot = novo_slot_lote(sistema);
+    if (novoLote.vacina == -1 || novoLote.slot == -1) {
+        Error_exceeded_memory_capacity(saida, current_language);
+        return;
+    }
+
+    // Adding the batch to the system, to the batch index and to the heap of its vaccine.
+    *obtem_lote(sistema, novoLote.slot) = novoLote;
+    if (!insere_indice_lote(sistema, novoLote.slot)) {
+        liberta_slot_lote(sistema, novoLote.slot);
+        Error_exceeded_memory_capacity(saida, current_language);
+        return;
+    }
+    if (!insere_heap_lote(sistema, novoLote.slot)) {
+        remove_indice_lote(sistema, lote);
+        liberta_slot_lote(sistema, novoLote.slot);
+        Error_exceeded_memory_capacity(saida, current_language);
+        return;
+    }
+    sistema->numLotes++;
+    insere_ordem_lote(sistema, novoLote.slot);
+    sistema->numAlteracoes++;
+    escreve_linha(saida, lote);
+}
+
+/**
+ * @brief Lists all vaccine batches or those matching specific names.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param linha Parameters of the command, which are split in place.
+ * @param saida Output where the results are written.
+ * @param current_language Language for error messages.
+ * 
+ * @note If a batch name is provided and it is not found, the following error 
+ * message is printed <vaccine_name>: no such vaccine. The batches are
+ * listed as they were when the command started, while others change them.
+ * 
+ * @return Prints the details of the batches or an error message 
+ * if a batch name is provided and it is not found.
+*/
+void comandol(Sistema *sistema, char *linha, Saida *saida, char *current_language) {
+    // Extracting the batch names from the input line.
+    char *token = strtok(linha, " ");
+
+    /* If batch names are provided, check if the provided names exist in the 
+    system,if they do not exist print an error message.*/
+    // Otherwise, list all batches. 
+    if (token != NULL) {
+        VersaoLote *lotes;
+        unsigned int versao;
+        int numLotes = le_lotes(sistema, &lotes, &versao);
+        if (numLotes == -1) {
+            Error_exceeded_memory_capacity(saida, current_language);
+            return;
+        }
+        for (; token != NULL; token = strtok(NULL, " ")) {
+            int existe = 0;
+            for (int j = 0; j < numLotes; j++) {
+                if (strcmp(obtem_lote(sistema, lotes[j].slot)->nome, token) == 0) {
+                    escreve_lote(saida, sistema, &lotes[j]);
+                existe = 1;}
+            }if (!existe) {
+                escreve_texto(saida, token);
+                escreve_texto(saida, ": ");
+                Error_non_existent_vaccine(saida, current_language);
+            }
+        }
+        termina_leitura(sistema, versao);
+        free(lotes);
+    } else {
+        all_batches(sistema, saida, current_language);
+    }
+}
+
+/**
+ * @brief Vaccinates a user with a specific vaccine batch
+ * with the oldest vaccine in the systems as long as that
+ * vaccine is available and if it is not expired.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param linha Parameters of the command, which are split in place.
+ * @param registo Record of the command, appended to the journal if the
+ * user is vaccinated, or NULL.
+ * @param saida Output where the results are written.
+ * @param current_language Language for error messages.
+ * 
+ * @note Possible Errors:
+ * - no stock
+ * - already vaccinated
+ * - exceeded memory capacity
+ * 
+ * @note Vaccinations run at the same time as others, each locking the
+ * shard of its vaccine and then the shard of its user.
+ *
+ * @return On success prints the batch number, otherwise prints an error message.
+ */
+void comandoa(Sistema *sistema, char *linha, RegistoJournal *registo, Saida *saida,
+              char *current_language) {
+    // Extracting user and vaccine names from the input line.
+    char *nomeUtente, *nomeVacina;
+    extrai_parametros_a(linha, &nomeUtente, &nomeVacina);
+    int vacina = procura_nome(&sistema->indiceVacinas, nomeVacina);
+    pthread_mutex_t *bloqueioVacina =
+        &sistema->fatiasVacinas[vacina & (NUM_FATIAS - 1)].bloqueio;
+    pthread_mutex_t *bloqueioUtente =
+        &sistema->fatiasUtentes[fatia_utente(nomeUtente)].bloqueio;
+
+    /* Looking for the vaccine batch in the system
+    if no valid vaccine is found or if the user has been
+    vaccinated by a vaccine with the same name on the 
+    same date print an error.*/
+    Lote *loteSelecionado = NULL;
+    bloqueia(bloqueioVacina, sistema->concorrente);
+    search_for_vaccine(sistema, vacina, &loteSelecionado, saida, current_language);
+    if (loteSelecionado != NULL) {
+        bloqueia(bloqueioUtente, sistema->concorrente);
+        if (already_vaccinated(sistema, nomeUtente, saida, current_language, loteSelecionado)) {
+            // Vaccination process.
+            inocullation(loteSelecionado, sistema, nomeUtente, registo, saida,
+                         current_language);
+        }
+        desbloqueia(bloqueioUtente, sistema->concorrente);
+    }
+    desbloqueia(bloqueioVacina, sistema->concorrente);
+}
+
+/**
+ * @brief Deletes a vaccine batch or sets its quantity to zero.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param linha Parameters of the command, which are split in place.
+ * @param saida Output where the results are written.
+ * @param current_language Language for error messages.
+ * 
+ * @note If the batch is not found, an error message is printed
+ * in the format <batch>: no such batch.
+ * 
+ * @return Prints the number of inoculations deleted or an error 
+ * message if the batch is not found.
+ */
+void comandor(Sistema *sistema, char *linha, Saida *saida, char *current_language) {
+    // Read the batch from the input line.
+    char *lote = proxima_palavra(&linha);
+    if (lote == NULL) lote = "";
+
+    /* Check if the batch exists in the system and get the number of 
+    inoculations and if said number is 0 delete the batch.*/
+    int i = procura_lote(sistema, lote);
+    if (i != -1) {
+        int numInoculacoesV = obtem_lote(sistema, i)->numInoculacoes;
+        remove_heap_lote(sistema, i);
+        if (numInoculacoesV == 0) {
+            remove_lote(sistema, i);
+        } else {
+            obtem_lote(sistema, i)->quantidade = 0;
+        }
+        sistema->numAlteracoes++;
+        escreve_inteiro(saida, numInoculacoesV);
+        escreve_caracter(saida, '\n');
+    }
+
+    // If the batch was not found print the error message <batch>: no such batch.
+    else {
+        escreve_texto(saida, lote);
+        escreve_texto(saida, ": ");
+        Error_non_existent_batch(saida, current_language);
+    }
+}
+
+
+/**
+ * @brief Changes the expiry date of a batch.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param linha Parameters of the command, which are split in place.
+ * @param saida Output where the results are written.
+ * @param current_language Language for error messages.
+ * 
+ * @note Room in the heap of its vaccine is made before the batch
+ * changes, so a batch with stock is never left out of it.
+ */
+void comandov(Sistema *sistema, char *linha, Saida *saida, char *current_language){
+    char *lote = proxima_palavra(&linha);
+    int dia = 0, mes = 0, ano = 0;
+    if (lote == NULL) lote = "";
+    proxima_data(&linha, &dia, &mes, &ano);
+    int i = procura_lote(sistema, lote);
+    if (i == -1) {
+        escreve_texto(saida, lote);
+        escreve_linha(saida, ": no such batch");
+        return;
+    }
+    // Check if the date exists and is not before the current date of the system.
+    if (!data_existe(dia, mes, ano) || empacota_data(dia, mes, ano) < sistema->data_atual) {
+        escreve_linha(saida, "invalid date");
+        return;
+    }
+    // Reposition the batch in the sorted order with its new date.
+    Lote *loteAlterado = obtem_lote(sistema, i);
+    if (loteAlterado->posHeap == -1 && loteAlterado->quantidade > 0 &&
+        !reserva_heap_lote(sistema, i)) {
+        Error_exceeded_memory_capacity(saida, current_language);
+        return;
+    }
+    remove_ordem_lote(sistema, i);
+    loteAlterado->data = empacota_data(dia, mes, ano);
+    insere_ordem_lote(sistema, i);
+    sistema->numAlteracoes++;
+
+    // Reposition the batch in the heap of its vaccine, it may be valid again.
+    if (loteAlterado->posHeap != -1) {
+        atualiza_heap_lote(sistema, i);
+    } else if (loteAlterado->quantidade > 0) {
+        insere_heap_lote(sistema, i);
+    }
+    escreve_inteiro(saida, loteAlterado->quantidade);
+    escreve_caracter(saida, '\n');
+    return;
+}
+/**
+ * @brief Deletes inoculations from the system.
+ * @details This function deletes inoculations based on the user name
+ *  or user name and date or username,date and batch number.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param linha Parameters of the command, which are split in place.
+ * @param saida Output where the results are written.
+ * @param current_language Language for error messages.
+ * 
+ * @note Possible Errors:
+ * - <username>: no such user
+ * - invalid date
+ * - <batch>: no such batch
+ *
+ * @return Prints the number of inoculations deleted or an error message.
+*/
+void comandod(Sistema *sistema, char *linha, Saida *saida, char *current_language) {
+    // Initialize variables and extract the parameters from the input line.
+    int dia = -1, mes = -1, ano = -1;
+    int numArgs = 0;
+    char *lote = "";
+
+    // If no arguments are provided, return.
+    char *nomeUtente = proxima_palavra(&linha);
+    if (nomeUtente == NULL) {
+        return;
+    }
+    numArgs = 1 + proxima_data(&linha, &dia, &mes, &ano);
+    if (numArgs == 4 && (lote = proxima_palavra(&linha)) != NULL) {
+        numArgs++;
+    }
+    // Check if the batch exists in the system.
+    if (numArgs == 5) {
+        if (!existing_batch(sistema, lote, saida, current_language)) {
+            return;
+        }
+    }
+    // Check if the data is valid.
+    if (numArgs >= 4 && !datavalidaHistory(dia, mes, ano, sistema, saida, current_language)) {
+        return;
+    }
+    /* Check if the user exists in the system and delete
+    inoculations based on the provided arguments.*/    
+    Data data = numArgs >= 4 && data_existe(dia, mes, ano) ?
+                empacota_data(dia, mes, ano) : DATA_INVALIDA;
+    delete_inocullations(sistema, nomeUtente, saida, current_language, data, lote, numArgs);
+}
+
+/**
+ * @brief Lists all inoculations or those matching a specific user.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param linha Parameters of the command, which are split in place.
+ * @param saida Output where the results are written.
+ * @param current_language Language for error messages.
+ * 
+ * @note If a user name is provided and it is not found, an error message 
+ * is printed in the format <username>: no such user. The inoculations
+ * are listed as they were when the command started, while others change them.
+ * 
+ * @return Prints the details of the inoculations or an error message
+ *  if a user name is provided and it is not found.
+ */
+void comandou(Sistema *sistema, char *linha, Saida *saida, char *current_language) {
+    // If no user name is provided, list all inoculations.
+    if (linha[0] == '\0') {
+        all_inocullations(sistema, saida);
+    } else {
+        // Extract user name from the input line.
+        char *nomeUtente = "";
+        if (linha[1] == '"') {
+            char *start = strchr(linha, '"');
+            char *end = strrchr(linha, '"');
+            if (start != end) {
+                *end = '\0';
+                nomeUtente = start + 1;
+            }
+        } else if ((nomeUtente = proxima_palavra(&linha)) == NULL) {
+            nomeUtente = "";
+        }
+        // Check if the user exists in the system and list their inoculations.
+        user_inocullations(sistema, nomeUtente, saida, current_language);
+    }
+}
+
+/**
+ * @brief Updates or gives the current date of the system.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param linha Parameters of the command, which are split in place.
+ * @param saida Output where the results are written.
+ * @param current_language Language for error messages.
+ * 
+ * @note If the date is invalid, an error message is printed
+ * with the message "invalid date".
+ * 
+ * @return Prints the updated date in the format dd-mm-yyyy.
+ */
+void comandot(Sistema *sistema, char *linha, Saida *saida, char *current_language) {
+    // If no date is provided, print the current date.
+    if (linha[0] == '\0') {
+        escreve_data(saida, sistema->data_atual);
+        escreve_caracter(saida, '\n');
+        return;
+    }
+    
+    // Extract day, month, and year from the input line.
+    int dia, mes, ano;
+
+    // Check if the input format is valid.
+    if (proxima_data(&linha, &dia, &mes, &ano) != 3) {
+        return;
+    }
+    
+    // Check if the date is valid.
+    if (!datavalida(dia, mes, ano, sistema, saida, current_language)){
+        return;
+    }
+    
+    // Update the system date and print it.
+    sistema->data_atual = empacota_data(dia, mes, ano);
+    remove_lotes_expirados(sistema);
+    sistema->numAlteracoes++;
+    escreve_data(saida, sistema->data_atual);
+    escreve_caracter(saida, '\n');
+}
+
+/**
+ * @brief Saves the whole system to a snapshot file, which can be
+ * loaded when the program starts with "--snapshot <file>".
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param linha Parameters of the command, which are split in place.
+ * @param journal Journal of the system, or NULL if there is none.
+ * @param saida Output where the results are written.
+ * @param current_language Language for error messages.
+ * 
+ * @note The journal is synced first and the snapshot keeps its
+ * position, so only the commands after it are replayed on top of
+ * the snapshot. If the file cannot be written, the error message
+ * "cannot save snapshot" is printed.
+ */
+void comandog(Sistema *sistema, char *linha, Journal *journal, Saida *saida,
+              char *current_language) {
+    char *ficheiro = proxima_palavra(&linha);
+    long long posicaoJournal = 0;
+    if (journal != NULL) {
+        if (!sincroniza_journal(journal)) {
+            Error_write_journal(saida, current_language);
+            return;
+        }
+        posicaoJournal = journal->posicao;
+    }
+    if (ficheiro == NULL || !guarda_snapshot(sistema, ficheiro, posicaoJournal)) {
+        Error_save_snapshot(saida, current_language);
+    }
+}
+
+/**
+ * @brief Prints the statistics of the commands run so far: for each
+ * command letter, the number of times it ran, the total time and the
+ * p50, p99, p999 and maximum latencies, in nanoseconds, followed by the
+ * number of errors of each type.
+ * 
+ * @param estatisticas Pointer to the statistics of the commands.
+ * @param saida Output where the results are written.
+ * @param current_language Language for error messages.
+ */
+void comandoe(Estatisticas *estatisticas, Saida *saida, char *current_language) {
+    escreve_estatisticas(estatisticas, saida);
+    escreve_contagem_erros(saida, current_language);
+}
+
+/**
+ * @brief Prints the memory taken by each data structure of the system,
+ * as "<structure> <reserved> <used> <slack> <overhead>" lines in bytes,
+ * followed by the total. The slack is what the growth of the arrays
+ * leaves unused, and the overhead is an estimate of what malloc adds.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param saida Output where the results are written.
+ */
+void comandom(Sistema *sistema, Saida *saida) {
+    escreve_memoria(sistema, saida);
+}
+
+/**
+ * @brief Runs a command that only depends on the system, given the
+ * rest of its line.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param comando Letter of the command.
+ * @param linha Parameters of the command, which are split in place.
+ * @param saida Output where the results are written.
+ * @param current_language Language for error messages.
+ * 
+ * @note Unknown commands are ignored.
+ */
+void executa_comando(Sistema *sistema, int comando, char *linha, Saida *saida,
+                     char *current_language) {
+    switch(comando) {
+        case 'c': comandoc(sistema, linha, saida, current_language); break;
+        case 'l': comandol(sistema, linha, saida, current_language); break;
+        case 'a': comandoa(sistema, linha, NULL, saida, current_language); break;
+        case 'r': comandor(sistema, linha, saida, current_language); break;
+        case 'd': comandod(sistema, linha, saida, current_language); break;
+        case 'u': comandou(sistema, linha, saida, current_language); break;
+        case 't': comandot(sistema, linha, saida, current_language); break;
+        case 'v': comandov(sistema, linha, saida, current_language); break;
+        case 'm': comandom(sistema, saida); break;
+        default: break;
+    }
+}
+
+/**
+ * @brief Checks if a command can change the system, and so may be added
+ * to the journal.
+ * 
+ * @param comando Letter of the command.
+ * 
+ * @return 1 if the command can change the system, 0 otherwise.
+ */
+static int altera_sistema(int comando) {
+    switch(comando) {
+        case 'c': case 'a': case 'r': case 'd': case 't': case 'v': return 1;
+        default: return 0;
+    }
+}
+
+/**
+ * @brief Runs a command read from a client of the system, given the
+ * rest of its line: the commands that only depend on the system, "g"
+ * and "e". The commands that change the system are added to the journal.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param journal Pointer to the journal, or NULL if there is none.
+ * @param estatisticas Pointer to the statistics of the commands.
+ * @param comando Letter of the command.
+ * @param linha Parameters of the command, which are split in place.
+ * @param saida Output where the results are written.
+ * @param current_language Language for error messages.
+ * 
+ * @note While the system is shared, vaccinations run at the same time
+ * as each other and every other command runs alone, except the listings,
+ * which only lock the system to take their version and then run at the
+ * same time as any command. If the journal cannot be written, the error
+ * message "cannot write journal" is printed after the results of the command.
+ */
+void processa_comando(Sistema *sistema, Journal *journal, Estatisticas *estatisticas,
+                      int comando, char *linha, Saida *saida, char *current_language) {
+    // Only the commands that can change the system copy their line for the journal.
+    RegistoJournal registo;
+    prepara_registo_journal(&registo, altera_sistema(comando) ? journal : NULL, comando, linha);
+    int listagem = comando == 'l' || comando == 'u';
+    if (!listagem) bloqueia_sistema(sistema, comando != 'a');
+    if (comando == 'g') {
+        comandog(sistema, linha, journal, saida, current_language);
+    } else if (comando == 'e') {
+        comandoe(estatisticas, saida, current_language);
+    } else {
+        if (comando == 'a') {
+            comandoa(sistema, linha, &registo, saida, current_language);
+        } else if (listagem) {
+            executa_comando(sistema, comando, linha, saida, current_language);
+        } else {
+            unsigned int numAlteracoes = sistema->numAlteracoes;
+            executa_comando(sistema, comando, linha, saida, current_language);
+            if (sistema->numAlteracoes != numAlteracoes) acrescenta_registo_journal(&registo);
+        }
+        if (journal != NULL && falhou_journal(journal)) {
+            Error_write_journal(saida, current_language);
+        }
+    }
+    if (!listagem) desbloqueia_sistema(sistema);
+    liberta_registo_journal(&registo);
+}
@@ -1,37 +1,57 @@
-/**
- * Declarations for commands used in the vaccination system.
- * @file: commands.h
- * @author: ist1114613 (João Tamagnini)
- */
-#ifndef COMMANDS_H
-#define COMMANDS_H
-#include "headers.h"
-
-/// @defgroup Commands Command execution functions.
-/// @{
-
-/// Creates a new vaccine batch.
-void comandoc(Sistema *sistema,char *current_language);
-
-/// Lists all vaccine batches or those matching a specific name.
-void comandol(Sistema *sistema,char *current_language);
-
-/// Vaccinates a user with a specific vaccine batch.
-void comandoa(Sistema *sistema, char *current_language);
-
-/// Removes a batch's availability.
-void comandor(Sistema *sistema,char *current_language);
-
-void comandov(Sistema *sistema);
-
-/// Deletes a user's vaccination history.
-void comandod(Sistema *sistema, char *current_language);
-
-/// Lists all vaccinations or those matching a specific user.
-void comandou(Sistema *sistema,char *current_language);
-
-/// Updates or gives the current date of the system.
-void comandot(Sistema *sistema, char *current_language);
-
-/// @}
+/**
+ * Declarations for commands used in the vaccination system.
+ * @file: commands.h
+ * @author: ist1114613 (João Tamagnini)
+ */
+#ifndef COMMANDS_H
+#define COMMANDS_H
+#include "headers.h"
+
+/// @defgroup Commands Command execution functions.
+/// @{
+
+/// Creates a new vaccine batch.
+void comandoc(Sistema *sistema, char *linha, Saida *saida, char *current_language);
+
+/// Lists all vaccine batches or those matching a specific name.
+void comandol(Sistema *sistema, char *linha, Saida *saida, char *current_language);
+
+/// Vaccinates a user with a specific vaccine batch.
+void comandoa(Sistema *sistema, char *linha, RegistoJournal *registo, Saida *saida,
+              char *current_language);
+
+/// Removes a batch's availability.
+void comandor(Sistema *sistema, char *linha, Saida *saida, char *current_language);
+
+/// Changes the expiry date of a batch.
+void comandov(Sistema *sistema, char *linha, Saida *saida, char *current_language);
+
+/// Deletes a user's vaccination history.
+void comandod(Sistema *sistema, char *linha, Saida *saida, char *current_language);
+
+/// Lists all vaccinations or those matching a specific user.
+void comandou(Sistema *sistema, char *linha, Saida *saida, char *current_language);
+
+/// Updates or gives the current date of the system.
+void comandot(Sistema *sistema, char *linha, Saida *saida, char *current_language);
+
+/// Saves the system to a snapshot file.
+void comandog(Sistema *sistema, char *linha, Journal *journal, Saida *saida,
+              char *current_language);
+
+/// Prints the statistics of the commands and the count of errors.
+void comandoe(Estatisticas *estatisticas, Saida *saida, char *current_language);
+
+/// Prints the memory taken by each data structure of the system.
+void comandom(Sistema *sistema, Saida *saida);
+
+/// Runs a command that only depends on the system.
+void executa_comando(Sistema *sistema, int comando, char *linha, Saida *saida,
+                     char *current_language);
+
+/// Runs a command read from a client of the system.
+void processa_comando(Sistema *sistema, Journal *journal, Estatisticas *estatisticas,
+                      int comando, char *linha, Saida *saida, char *current_language);
+
+/// @}
 #endif
\ No newline at end of file
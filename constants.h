@@ -1,115 +1,330 @@
-/** 
-* A file to include all the constants used in the project 
-* @file constants.h
-* @author: ist1114613 (João Tamagnini)
-*/
-
-#ifndef CONSTANTS
-#define CONSTANTS
-
-/// @defgroup Constants_Mem constants used for memory allocation and limits.
-/// @{
-
-/// Maximum number of vaccine batches.
-#define MAX_LOTES 1000
-
-/// Maximum length of a vaccine name.
-#define MAX_NOME 50
-
-/// Maximum length of a batch number.
-#define MAX_LOTE 20
-
-/// Maximum length of a date string.
-#define MAX_DATA 20
-
-/// Maximum length of an instruction string.
-#define MAX_INSTRUCAO 65535
-
-/// Usual length of a user name.
-#define N_UTENTE 200
-
-/// @}
-
-/// @defgroup Constants_Errors constants used for error messages in english.
-/// @{
-
-/// Error message for exceeding memory capacity.
-#define ENOMEMORY_EN "No memory."
-
-/// Error message for exceeding the maximum number of vaccine batches.
-#define E2MANYCONT_EN "too many vaccines"
-
-/// Error message for creating a batch with a duplicate batch number.
-#define EDUPBATCH_EN "duplicate batch number"
-
-/// Error message for creating a batch with invalid characters or exceeding the maximum length.
-#define EINVBATCH_EN "invalid batch"
-
-/// Error message for creating a vaccine name with invalid characters or exceeding the maximum length.
-#define EINVNAME_EN "invalid name"
-
-/// Error message for providing an invalid date.
-#define EINVDATE_EN "invalid date"
-
-/// Error message for providing an invalid quantity.
-#define EINVQUANT_EN "invalid quantity"
-
-/// Error message for attempting to use a vaccine batch with no stock.
-#define ENOSTOCK_EN "no stock"
-
-/// Error message for attempting to vaccinate a user who has already been vaccinated.
-#define EALVACC_EN "already vaccinated"
-
-/// Error message for referencing a non-existent vaccine.
-#define ENOSUCHV_EN "no such vaccine"
-
-/// Error message for referencing a non-existent batch.
-#define ENOSUCHBATCH_EN "no such batch"
-
-/// Error message for referencing a non-existent user.
-#define ENOSUCHUSER_EN "no such user"
-
-/// @}
-
-/// @defgroup Constants_Errors_PT constants used for error messages in portuguese.
-/// @{
-
-/// Mensagem de erro para capacidade de memória excedida.
-#define ENOMEMORY_PT "sem memória"
-
-/// Mensagem de erro para exceder o número máximo de lotes de vacinas.
-#define E2MANYCONT_PT "demasiadas vacinas"
-
-/// Mensagem de erro para criar um lote com um número duplicado.
-#define EDUPBATCH_PT "número de lote duplicado"
-
-/// Mensagem de erro para criar um lote com caracteres inválidos ou comprimento excedido.
-#define EINVBATCH_PT "lote inválido"
-
-/// Mensagem de erro para criar um nome de vacina com caracteres inválidos ou comprimento excedido.
-#define EINVNAME_PT "nome inválido"
-
-/// Mensagem de erro para fornecer uma data inválida.
-#define EINVDATE_PT "data inválida"
-
-/// Mensagem de erro para fornecer uma quantidade inválida.
-#define EINVQUANT_PT "quantidade inválida"
-
-/// Mensagem de erro para tentar usar um lote de vacinas sem stock.
-#define ENOSTOCK_PT "esgotado"
-
-/// Mensagem de erro para tentar vacinar um utente já vacinado.
-#define EALVACC_PT "já vacinado"
-
-/// Mensagem de erro para referenciar uma vacina inexistente.
-#define ENOSUCHV_PT "vacina inexistente"
-
-/// Mensagem de erro para referenciar um lote inexistente.
-#define ENOSUCHBATCH_PT "lote inexistente"
-
-/// Mensagem de erro para referenciar um utente inexistente.
-#define ENOSUCHUSER_PT "utente inexistente"
-
-/// @}
-
+/** 
+* A file to include all the constants used in the project 
+* @file constants.h
+* @author: ist1114613 (João Tamagnini)
+*/
+
+#ifndef CONSTANTS
+#define CONSTANTS
+
+/// @defgroup Constants_Mem constants used for memory allocation and limits.
+/// @{
+
+/// Maximum number of vaccine batches when the batch limit is enabled.
+#define MAX_LOTES 1000
+
+/// Number of batches in each block of the batch storage.
+#define LOTES_POR_BLOCO 1024
+
+/// Maximum length of a vaccine name.
+#define MAX_NOME 50
+
+/// Maximum length of a batch number.
+#define MAX_LOTE 20
+
+/// Number of bytes read from the input at a time.
+#define TAM_BLOCO_LEITURA (1 << 20)
+
+/// Number of bytes of output kept before they are written.
+#define TAM_BLOCO_ESCRITA (1 << 20)
+
+/// Number of formatted dates kept by an output (power of two).
+#define TAM_CACHE_DATAS 1024
+
+/// Largest year that can be stored in a packed date.
+#define ANO_MAXIMO ((1 << 22) - 1)
+
+/// Packed date that does not match any existing date.
+#define DATA_INVALIDA -1
+
+/// Identifier at the start of a snapshot file.
+#define SNAPSHOT_MAGICA "VACSNAP"
+
+/// Version of the format of the snapshot files.
+#define SNAPSHOT_VERSAO 5
+
+/// Identifier at the start of a journal file.
+#define JOURNAL_MAGICA "VACJRNL"
+
+/// Version of the format of the journal files.
+#define JOURNAL_VERSAO 1
+
+/// Number of bytes of journal records kept before they are written.
+#define TAM_BLOCO_JOURNAL (1 << 16)
+
+/// Number of bytes first read from each client of the server.
+#define TAM_ENTRADA_CONEXAO (1 << 16)
+
+/// Number of bytes of answers kept for each client of the server before they are written.
+#define TAM_SAIDA_CONEXAO (1 << 16)
+
+/// Number of bytes of unsent answers after which the commands of a client wait.
+#define LIMITE_SAIDA_CONEXAO (1 << 16)
+
+/// Number of events handled by each wait of the server.
+#define MAX_EVENTOS 64
+
+/// Number of pending connections kept by the socket of the server.
+#define MAX_PENDENTES 128
+
+/// Maximum number of threads of the server.
+#define MAX_FIOS 256
+
+/// Number of bits of the id of a user that give its shard.
+#define BITS_FATIAS 6
+
+/// Number of shards of the users and of the vaccines, each with its own lock.
+#define NUM_FATIAS (1 << BITS_FATIAS)
+
+/// Number of bytes of a cache line, to keep the locks of the shards apart.
+#define TAM_LINHA_CACHE 64
+
+/// Number of bytes of a journal record kept on the stack before it is appended.
+#define TAM_REGISTO_LOCAL 256
+
+/// Number of blocks that go round between two stages of the pipeline, half a ring (power of two).
+#define NUM_BLOCOS_PIPELINE 8
+
+/// Number of bytes of each block of commands or of output of the pipeline.
+#define TAM_BLOCO_PIPELINE (1 << 16)
+
+/// Number of times a stage of the pipeline checks its ring before it sleeps.
+#define ESPERA_ATIVA 1000
+
+/// File descriptor of an output that keeps all its text, for the threads that format listings.
+#define SAIDA_MEMORIA -2
+
+/// Number of inoculations each thread formats in a round of a large listing.
+#define FATIA_LISTAGEM (1 << 14)
+
+/// Number of inoculations below which a round of a listing is formatted by its own thread only.
+#define MIN_LISTAGEM_PARALELA 4096
+
+/// Version in which an inoculation that was not deleted is deleted.
+#define VERSAO_VIVA 0xFFFFFFFFu
+
+/// Type of the retired memory, freed once no listing can read it.
+#define RETIRADO_MEMORIA 0
+
+/// Type of the retired batch slots, reused once no listing can read them.
+#define RETIRADO_LOTE 1
+
+/// Type of the deleted inoculations, unlinked once no listing shows them.
+#define RETIRADO_INOCULACAO 2
+
+/// Type of the unlinked inoculations, reused once no listing is on them.
+#define RETIRADO_DESLIGADA 3
+
+/// Number of bits of the sub-buckets of each power of two of a latency histogram.
+#define BITS_SUBBALDES 5
+
+/// Latencies are kept up to 2^BITS_LATENCIA nanoseconds (about 18 minutes).
+#define BITS_LATENCIA 40
+
+/// Number of buckets of a latency histogram.
+#define NUM_BALDES_LATENCIA ((BITS_LATENCIA - BITS_SUBBALDES + 1) << BITS_SUBBALDES)
+
+/// Number of command letters with statistics (lowercase letters).
+#define NUM_LETRAS_COMANDO 26
+
+/// Alignment of the blocks given by malloc, used to estimate their real size.
+#define ALINHAMENTO_MALLOC 16
+
+/// Smallest block given by malloc.
+#define MINIMO_MALLOC 32
+
+/// Size from which malloc maps the blocks as whole pages.
+#define LIMIAR_MMAP (128 * 1024)
+
+/// Size of a memory page.
+#define TAM_PAGINA 4096
+
+/// Initial number of positions of a name index (power of two).
+#define TAM_INICIAL_INDICE 64
+
+/// Initial capacity of the heap of batches of a vaccine.
+#define CAP_INICIAL_HEAP 4
+
+/// Number of inoculations in each segment of the inoculation storage (power of two).
+#define INOCULACOES_POR_SEGMENTO (1 << 16)
+
+/// Initial capacity of the list of inoculations of a user.
+#define CAP_INICIAL_UTENTE 4
+
+/// Number of bytes in each block of the arena of names.
+#define TAM_BLOCO_NOMES (1 << 16)
+
+/// @}
+
+/// @defgroup Constants_Error_Types constants used to count the errors by type.
+/// @{
+
+/// Type of the errors for exceeding memory capacity.
+#define ERRO_MEMORIA 0
+
+/// Type of the errors for exceeding the maximum number of vaccine batches.
+#define ERRO_DEMASIADAS_VACINAS 1
+
+/// Type of the errors for a duplicate batch number.
+#define ERRO_LOTE_DUPLICADO 2
+
+/// Type of the errors for an invalid batch.
+#define ERRO_LOTE_INVALIDO 3
+
+/// Type of the errors for an invalid name.
+#define ERRO_NOME_INVALIDO 4
+
+/// Type of the errors for an invalid date.
+#define ERRO_DATA_INVALIDA 5
+
+/// Type of the errors for an invalid quantity.
+#define ERRO_QUANTIDADE_INVALIDA 6
+
+/// Type of the errors for a batch with no stock.
+#define ERRO_SEM_STOCK 7
+
+/// Type of the errors for a user already vaccinated.
+#define ERRO_JA_VACINADO 8
+
+/// Type of the errors for a non-existent vaccine.
+#define ERRO_VACINA_INEXISTENTE 9
+
+/// Type of the errors for a non-existent batch.
+#define ERRO_LOTE_INEXISTENTE 10
+
+/// Type of the errors for a non-existent user.
+#define ERRO_UTENTE_INEXISTENTE 11
+
+/// Type of the errors for failing to save a snapshot.
+#define ERRO_GUARDAR_SNAPSHOT 12
+
+/// Type of the errors for failing to load a snapshot.
+#define ERRO_CARREGAR_SNAPSHOT 13
+
+/// Type of the errors for failing to write the journal.
+#define ERRO_ESCREVER_JOURNAL 14
+
+/// Type of the errors for failing to load the journal.
+#define ERRO_CARREGAR_JOURNAL 15
+
+/// Type of the errors for failing to listen on the socket of the server.
+#define ERRO_SOCKET 16
+
+/// Number of types of errors.
+#define NUM_TIPOS_ERRO 17
+
+/// @}
+
+/// @defgroup Constants_Errors constants used for error messages in english.
+/// @{
+
+/// Error message for exceeding memory capacity.
+#define ENOMEMORY_EN "No memory."
+
+/// Error message for exceeding the maximum number of vaccine batches.
+#define E2MANYCONT_EN "too many vaccines"
+
+/// Error message for creating a batch with a duplicate batch number.
+#define EDUPBATCH_EN "duplicate batch number"
+
+/// Error message for creating a batch with invalid characters or exceeding the maximum length.
+#define EINVBATCH_EN "invalid batch"
+
+/// Error message for creating a vaccine name with invalid characters or exceeding the maximum length.
+#define EINVNAME_EN "invalid name"
+
+/// Error message for providing an invalid date.
+#define EINVDATE_EN "invalid date"
+
+/// Error message for providing an invalid quantity.
+#define EINVQUANT_EN "invalid quantity"
+
+/// Error message for attempting to use a vaccine batch with no stock.
+#define ENOSTOCK_EN "no stock"
+
+/// Error message for attempting to vaccinate a user who has already been vaccinated.
+#define EALVACC_EN "already vaccinated"
+
+/// Error message for referencing a non-existent vaccine.
+#define ENOSUCHV_EN "no such vaccine"
+
+/// Error message for referencing a non-existent batch.
+#define ENOSUCHBATCH_EN "no such batch"
+
+/// Error message for referencing a non-existent user.
+#define ENOSUCHUSER_EN "no such user"
+
+/// Error message for failing to save a snapshot.
+#define ESAVESNAP_EN "cannot save snapshot"
+
+/// Error message for failing to load a snapshot.
+#define ELOADSNAP_EN "cannot load snapshot"
+
+/// Error message for failing to write the journal.
+#define EWRITEJRNL_EN "cannot write journal"
+
+/// Error message for failing to load the journal.
+#define ELOADJRNL_EN "cannot load journal"
+
+/// Error message for failing to open the server socket.
+#define ESOCKET_EN "cannot open socket"
+
+/// @}
+
+/// @defgroup Constants_Errors_PT constants used for error messages in portuguese.
+/// @{
+
+/// Mensagem de erro para capacidade de memória excedida.
+#define ENOMEMORY_PT "sem memória"
+
+/// Mensagem de erro para exceder o número máximo de lotes de vacinas.
+#define E2MANYCONT_PT "demasiadas vacinas"
+
+/// Mensagem de erro para criar um lote com um número duplicado.
+#define EDUPBATCH_PT "número de lote duplicado"
+
+/// Mensagem de erro para criar um lote com caracteres inválidos ou comprimento excedido.
+#define EINVBATCH_PT "lote inválido"
+
+/// Mensagem de erro para criar um nome de vacina com caracteres inválidos ou comprimento excedido.
+#define EINVNAME_PT "nome inválido"
+
+/// Mensagem de erro para fornecer uma data inválida.
+#define EINVDATE_PT "data inválida"
+
+/// Mensagem de erro para fornecer uma quantidade inválida.
+#define EINVQUANT_PT "quantidade inválida"
+
+/// Mensagem de erro para tentar usar um lote de vacinas sem stock.
+#define ENOSTOCK_PT "esgotado"
+
+/// Mensagem de erro para tentar vacinar um utente já vacinado.
+#define EALVACC_PT "já vacinado"
+
+/// Mensagem de erro para referenciar uma vacina inexistente.
+#define ENOSUCHV_PT "vacina inexistente"
+
+/// Mensagem de erro para referenciar um lote inexistente.
+#define ENOSUCHBATCH_PT "lote inexistente"
+
+/// Mensagem de erro para referenciar um utente inexistente.
+#define ENOSUCHUSER_PT "utente inexistente"
+
+/// Mensagem de erro para a falha ao guardar um snapshot.
+#define ESAVESNAP_PT "impossível guardar snapshot"
+
+/// Mensagem de erro para a falha ao carregar um snapshot.
+#define ELOADSNAP_PT "impossível carregar snapshot"
+
+/// Mensagem de erro para a falha ao escrever o journal.
+#define EWRITEJRNL_PT "impossível escrever journal"
+
+/// Mensagem de erro para a falha ao carregar o journal.
+#define ELOADJRNL_PT "impossível carregar journal"
+
+/// Mensagem de erro para a falha ao abrir o socket do servidor.
+#define ESOCKET_PT "impossível abrir socket"
+
+/// @}
+
 #endif 
\ No newline at end of file
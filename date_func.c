@@ -0,0 +1,30 @@
+/**
+ * Implementation of the packed dates used in the vaccination system.
+ * @file: date_func.c
+ * @author: ist1114613 (João Tamagnini)
+ */
+#include "headers.h"
+
+/// Number of days of each month, in common years and in leap years.
+static const int diasNoMes[2][13] = {
+    { 0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 },
+    { 0, 31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 }
+};
+
+/**
+ * @brief Checks if a day, month and year make an existing date
+ * that can be packed.
+ * 
+ * @param dia Day of the date.
+ * @param mes Month of the date.
+ * @param ano Year of the date.
+ * 
+ * @return 1 if the date exists, 0 otherwise.
+ */
+int data_existe(int dia, int mes, int ano) {
+    if (mes < 1 || mes > 12 || dia < 1 || ano < 0 || ano > ANO_MAXIMO) {
+        return 0;
+    }
+    int bissexto = ano % 4 == 0 && (ano % 100 != 0 || ano % 400 == 0);
+    return dia <= diasNoMes[bissexto][mes];
+}
@@ -0,0 +1,40 @@
+/**
+ * Declarations for the packed dates used in the vaccination system.
+ * @file: date_func.h
+ * @author: ist1114613 (João Tamagnini)
+ */
+#ifndef DATE_FUNC_H
+#define DATE_FUNC_H
+#include "headers.h"
+
+/// @defgroup date_funcs Date functions.
+/// @{
+
+/**
+ * @brief Packs a date in a single integer, so that dates can be
+ * compared with a single integer comparison.
+ * 
+ * @param dia Day of the date (1 to 31).
+ * @param mes Month of the date (1 to 12).
+ * @param ano Year of the date (0 to ANO_MAXIMO).
+ * 
+ * @return The packed date.
+ */
+static inline Data empacota_data(int dia, int mes, int ano) {
+    return (ano << 9) | (mes << 5) | dia;
+}
+
+/// Gets the day of a packed date.
+static inline int data_dia(Data data) { return data & 31; }
+
+/// Gets the month of a packed date.
+static inline int data_mes(Data data) { return (data >> 5) & 15; }
+
+/// Gets the year of a packed date.
+static inline int data_ano(Data data) { return data >> 9; }
+
+/// Checks if a day, month and year make an existing date.
+int data_existe(int dia, int mes, int ano);
+
+/// @}
+#endif
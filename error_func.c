@@ -1,165 +1,263 @@
-/**
- * Implementation of commands used to print errors based
- * on the current language.
- * 
- * @file: error_func.c
- * @author: ist1114613 (João Tamagnini)
- */
-
-#include "headers.h"
-
-/**
- * @brief Prints an error message for an invalid date.
- * 
- * @param current_language Language for error messages.
- */
-void Error_invalid_date(char *current_language) {
-    if (strcmp(current_language, "pt") == 0) {
-        printf("%s\n", EINVDATE_PT);
-    } else {
-        printf("%s\n", EINVDATE_EN);
-    }
-}
-
-/**
- * @brief Prints an error message for exceeding the maximum amount of batches.
- * 
- * @param current_language Language for error messages.
- */
-void Error_exceeded_batch_limit(char *current_language) {
-    if (strcmp(current_language, "pt") == 0) {
-        printf("%s\n", E2MANYCONT_PT);
-    } else {
-        printf("%s\n", E2MANYCONT_EN);
-    }
-}
-
-/**
- * @brief Prints an error message for exceeding memory capacity.
- * 
- * @param current_language Language for error messages.
- */
-void Error_exceeded_memory_capacity(char *current_language) {
-    if (strcmp(current_language, "pt") == 0) {
-        printf("%s\n", ENOMEMORY_PT);
-    } else {
-        printf("%s\n", ENOMEMORY_EN);
-    }
-}
-
-/**
- * @brief Prints an error message for an invalid name.
- * 
- * @param current_language Language for error messages.
- */
-void Error_invalid_name(char *current_language) {
-    if (strcmp(current_language, "pt") == 0) {
-        printf("%s\n", EINVNAME_PT);
-    } else {
-        printf("%s\n", EINVNAME_EN);
-    }
-}
-
-/**
- * @brief Prints an error message for a duplicated batch number.
- * 
- * @param current_language Language for error messages.
- */
-void Error_duplicated_batch(char *current_language) {
-    if (strcmp(current_language, "pt") == 0) {
-        printf("%s\n", EDUPBATCH_PT);
-    } else {
-        printf("%s\n", EDUPBATCH_EN);
-    }
-}
-
-/**
- * @brief Prints an error message for an invalid batch.
- * 
- * @param current_language Language for error messages.
- */
-void Error_invalid_batch(char *current_language) {
-    if (strcmp(current_language, "pt") == 0) {
-        printf("%s\n", EINVBATCH_PT);
-    } else {
-        printf("%s\n", EINVBATCH_EN);
-    }
-}
-
-/**
- * @brief Prints an error message for an invalid quantity.
- * 
- * @param current_language Language for error messages.
- */
-void Error_invalid_quantity(char *current_language) {
-    if (strcmp(current_language, "pt") == 0) {
-        printf("%s\n", EINVQUANT_PT);
-    } else {
-        printf("%s\n", EINVQUANT_EN);
-    }
-}
-
-/**
- * @brief Prints an error message for a non-existent vaccine.
- * 
- * @param current_language Language for error messages.
- */
-void Error_non_existent_vaccine(char *current_language) {
-    if (strcmp(current_language, "pt") == 0) {
-        printf("%s\n", ENOSUCHV_PT);
-    } else {
-        printf("%s\n", ENOSUCHV_EN);
-    }
-}
-
-/**
- * @brief Prints an error message for an absence of stock.
- * 
- * @param current_language Language for error messages.
- */
-void Error_no_stock(char *current_language) {
-    if (strcmp(current_language, "pt") == 0) {
-        printf("%s\n", ENOSTOCK_PT);
-    } else {
-        printf("%s\n", ENOSTOCK_EN);
-    }
-}
-
-/**
- * @brief Prints an error message for a user that has already been vaccinated.
- * 
- * @param current_language Language for error messages.
- */
-void Error_already_vaccinated(char *current_language) {
-    if (strcmp(current_language, "pt") == 0) {
-        printf("%s\n", EALVACC_PT);
-    } else {
-        printf("%s\n", EALVACC_EN);
-    }
-}
-
-/**
- * @brief Prints an error message for a non-existent batch.
- * 
- * @param current_language Language for error messages.
- */
-void Error_non_existent_batch(char *current_language) {
-    if (strcmp(current_language, "pt") == 0) {
-        printf("%s\n", ENOSUCHBATCH_PT);
-    } else {
-        printf("%s\n", ENOSUCHBATCH_EN);
-    }
-}
-
-/**
- * @brief Prints an error message for a non-existent user.
- * 
- * @param current_language Language for error messages.
- */
-void Error_non_existent_user(char *current_language) {
-    if (strcmp(current_language, "pt") == 0) {
-        printf("%s\n", ENOSUCHUSER_PT);
-    } else {
-        printf("%s\n", ENOSUCHUSER_EN);
-    }
-}
+/**
+ * Implementation of commands used to print errors based
+ * on the current language.
+ * 
+ * @file: error_func.c
+ * @author: ist1114613 (João Tamagnini)
+ */
+
+#include "headers.h"
+
+/// Error messages in english, by type of error.
+static const char *const mensagensEN[NUM_TIPOS_ERRO] = {
+    ENOMEMORY_EN,
+    E2MANYCONT_EN,
+    EDUPBATCH_EN,
+    EINVBATCH_EN,
+    EINVNAME_EN,
+    EINVDATE_EN,
+    EINVQUANT_EN,
+    ENOSTOCK_EN,
+    EALVACC_EN,
+    ENOSUCHV_EN,
+    ENOSUCHBATCH_EN,
+    ENOSUCHUSER_EN,
+    ESAVESNAP_EN,
+    ELOADSNAP_EN,
+    EWRITEJRNL_EN,
+    ELOADJRNL_EN,
+    ESOCKET_EN
+};
+
+/// Error messages in portuguese, by type of error.
+static const char *const mensagensPT[NUM_TIPOS_ERRO] = {
+    ENOMEMORY_PT,
+    E2MANYCONT_PT,
+    EDUPBATCH_PT,
+    EINVBATCH_PT,
+    EINVNAME_PT,
+    EINVDATE_PT,
+    EINVQUANT_PT,
+    ENOSTOCK_PT,
+    EALVACC_PT,
+    ENOSUCHV_PT,
+    ENOSUCHBATCH_PT,
+    ENOSUCHUSER_PT,
+    ESAVESNAP_PT,
+    ELOADSNAP_PT,
+    EWRITEJRNL_PT,
+    ELOADJRNL_PT,
+    ESOCKET_PT
+};
+
+/**
+ * @brief Gets the message of a type of error in the current language.
+ * 
+ * @param tipo Type of the error.
+ * @param current_language Language for error messages.
+ * 
+ * @return The message.
+ */
+static const char *mensagem_erro(int tipo, char *current_language) {
+    return strcmp(current_language, "pt") == 0 ? mensagensPT[tipo] : mensagensEN[tipo];
+}
+
+/**
+ * @brief Prints the message of a type of error and counts it in the output,
+ * whose counts the threads of the server may share.
+ * 
+ * @param saida Output where the message is written.
+ * @param current_language Language for error messages.
+ * @param tipo Type of the error.
+ */
+static void escreve_erro(Saida *saida, char *current_language, int tipo) {
+    __atomic_fetch_add(&saida->numErros[tipo], 1, __ATOMIC_RELAXED);
+    escreve_linha(saida, mensagem_erro(tipo, current_language));
+}
+
+/**
+ * @brief Prints how many errors of each type were written to an output,
+ * as "<count> <message>" lines, leaving out the types with no errors.
+ * 
+ * @param saida Output where the errors were written and the counts are written.
+ * @param current_language Language for error messages.
+ */
+void escreve_contagem_erros(Saida *saida, char *current_language) {
+    for (int tipo = 0; tipo < NUM_TIPOS_ERRO; tipo++) {
+        long long numErros = __atomic_load_n(&saida->numErros[tipo], __ATOMIC_RELAXED);
+        if (numErros == 0) continue;
+        escreve_longo(saida, numErros);
+        escreve_caracter(saida, ' ');
+        escreve_linha(saida, mensagem_erro(tipo, current_language));
+    }
+}
+
+/**
+ * @brief Prints an error message for an invalid date.
+ * 
+ * @param saida Output where the message is written.
+ * @param current_language Language for error messages.
+ */
+void Error_invalid_date(Saida *saida, char *current_language) {
+    escreve_erro(saida, current_language, ERRO_DATA_INVALIDA);
+}
+
+/**
+ * @brief Prints an error message for exceeding the maximum amount of batches.
+ * 
+ * @param saida Output where the message is written.
+ * @param current_language Language for error messages.
+ */
+void Error_exceeded_batch_limit(Saida *saida, char *current_language) {
+    escreve_erro(saida, current_language, ERRO_DEMASIADAS_VACINAS);
+}
+
+/**
+ * @brief Prints an error message for exceeding memory capacity.
+ * 
+ * @param saida Output where the message is written.
+ * @param current_language Language for error messages.
+ */
+void Error_exceeded_memory_capacity(Saida *saida, char *current_language) {
+    escreve_erro(saida, current_language, ERRO_MEMORIA);
+}
+
+/**
+ * @brief Prints an error message for an invalid name.
+ * 
+ * @param saida Output where the message is written.
+ * @param current_language Language for error messages.
+ */
+void Error_invalid_name(Saida *saida, char *current_language) {
+    escreve_erro(saida, current_language, ERRO_NOME_INVALIDO);
+}
+
+/**
+ * @brief Prints an error message for a duplicated batch number.
+ * 
+ * @param saida Output where the message is written.
+ * @param current_language Language for error messages.
+ */
+void Error_duplicated_batch(Saida *saida, char *current_language) {
+    escreve_erro(saida, current_language, ERRO_LOTE_DUPLICADO);
+}
+
+/**
+ * @brief Prints an error message for an invalid batch.
+ * 
+ * @param saida Output where the message is written.
+ * @param current_language Language for error messages.
+ */
+void Error_invalid_batch(Saida *saida, char *current_language) {
+    escreve_erro(saida, current_language, ERRO_LOTE_INVALIDO);
+}
+
+/**
+ * @brief Prints an error message for an invalid quantity.
+ * 
+ * @param saida Output where the message is written.
+ * @param current_language Language for error messages.
+ */
+void Error_invalid_quantity(Saida *saida, char *current_language) {
+    escreve_erro(saida, current_language, ERRO_QUANTIDADE_INVALIDA);
+}
+
+/**
+ * @brief Prints an error message for a non-existent vaccine.
+ * 
+ * @param saida Output where the message is written.
+ * @param current_language Language for error messages.
+ */
+void Error_non_existent_vaccine(Saida *saida, char *current_language) {
+    escreve_erro(saida, current_language, ERRO_VACINA_INEXISTENTE);
+}
+
+/**
+ * @brief Prints an error message for an absence of stock.
+ * 
+ * @param saida Output where the message is written.
+ * @param current_language Language for error messages.
+ */
+void Error_no_stock(Saida *saida, char *current_language) {
+    escreve_erro(saida, current_language, ERRO_SEM_STOCK);
+}
+
+/**
+ * @brief Prints an error message for a user that has already been vaccinated.
+ * 
+ * @param saida Output where the message is written.
+ * @param current_language Language for error messages.
+ */
+void Error_already_vaccinated(Saida *saida, char *current_language) {
+    escreve_erro(saida, current_language, ERRO_JA_VACINADO);
+}
+
+/**
+ * @brief Prints an error message for a non-existent batch.
+ * 
+ * @param saida Output where the message is written.
+ * @param current_language Language for error messages.
+ */
+void Error_non_existent_batch(Saida *saida, char *current_language) {
+    escreve_erro(saida, current_language, ERRO_LOTE_INEXISTENTE);
+}
+
+/**
+ * @brief Prints an error message for a non-existent user.
+ * 
+ * @param saida Output where the message is written.
+ * @param current_language Language for error messages.
+ */
+void Error_non_existent_user(Saida *saida, char *current_language) {
+    escreve_erro(saida, current_language, ERRO_UTENTE_INEXISTENTE);
+}
+
+/**
+ * @brief Prints an error message for failing to save a snapshot.
+ * 
+ * @param saida Output where the message is written.
+ * @param current_language Language for error messages.
+ */
+void Error_save_snapshot(Saida *saida, char *current_language) {
+    escreve_erro(saida, current_language, ERRO_GUARDAR_SNAPSHOT);
+}
+
+/**
+ * @brief Prints an error message for failing to load a snapshot.
+ * 
+ * @param saida Output where the message is written.
+ * @param current_language Language for error messages.
+ */
+void Error_load_snapshot(Saida *saida, char *current_language) {
+    escreve_erro(saida, current_language, ERRO_CARREGAR_SNAPSHOT);
+}
+
+/**
+ * @brief Prints an error message for failing to write the journal.
+ * 
+ * @param saida Output where the message is written.
+ * @param current_language Language for error messages.
+ */
+void Error_write_journal(Saida *saida, char *current_language) {
+    escreve_erro(saida, current_language, ERRO_ESCREVER_JOURNAL);
+}
+
+/**
+ * @brief Prints an error message for failing to load the journal.
+ * 
+ * @param saida Output where the message is written.
+ * @param current_language Language for error messages.
+ */
+void Error_load_journal(Saida *saida, char *current_language) {
+    escreve_erro(saida, current_language, ERRO_CARREGAR_JOURNAL);
+}
+
+/**
+ * @brief Prints an error message for failing to listen on the socket of the server.
+ * 
+ * @param saida Output where the message is written.
+ * @param current_language Language for error messages.
+ */
+void Error_open_socket(Saida *saida, char *current_language) {
+    escreve_erro(saida, current_language, ERRO_SOCKET);
+}
@@ -0,0 +1,191 @@
+/**
+ * Implementation of the threads that help format the large listings
+ * of the vaccination system.
+ * 
+ * A listing of all the inoculations collects the positions of those it
+ * shows in rounds, and each round is split in as many slices as there
+ * are threads. The thread of the listing formats the first slice into
+ * its output while each of the other threads formats its own slice into
+ * a text of its own, and then writes their texts in order, so the output
+ * is the same as formatting the whole round alone. The listing holds its
+ * version until it ends, so the inoculations of a round are not reused
+ * while the threads format them.
+ * 
+ * There is one set of threads, which a listing takes for all its rounds.
+ * A listing that starts while another has them formats alone.
+ * @file: format_func.c
+ * @author: ist1114613 (João Tamagnini)
+ */
+#include "headers.h"
+
+/**
+ * @brief Thread that formats its slice of each round of a listing into
+ * a text of its own, until the threads stop.
+ * 
+ * @param argumento Pointer to the vaccination system structure.
+ * 
+ * @return NULL.
+ */
+static void *formata(void *argumento) {
+    Sistema *sistema = (Sistema *)argumento;
+    Formatadores *formatadores = &sistema->formatadores;
+    int indice = __atomic_fetch_add(&formatadores->numIniciados, 1, __ATOMIC_RELAXED);
+    Saida saida;
+    inicia_saida(&saida, SAIDA_MEMORIA, TAM_BLOCO_ESCRITA);
+    unsigned int ronda = 0;
+    pthread_mutex_lock(&formatadores->bloqueio);
+    for (;;) {
+        while (formatadores->ronda == ronda && !formatadores->parar) {
+            pthread_cond_wait(&formatadores->inicio, &formatadores->bloqueio);
+        }
+        if (formatadores->parar) break;
+        ronda = formatadores->ronda;
+        long long numPosicoes = formatadores->numPosicoes;
+        long long numFatias = formatadores->numFios + 1;
+        pthread_mutex_unlock(&formatadores->bloqueio);
+
+        // The slice of the thread is after the one of the listing and those before it.
+        int inicio = (int)((indice + 1) * numPosicoes / numFatias);
+        int fim = (int)((indice + 2) * numPosicoes / numFatias);
+        saida.tamanho = 0;
+        for (int i = inicio; i < fim; i++) {
+            escreve_inoculacao(&saida, sistema,
+                               obtem_inoculacao(sistema, formatadores->posicoes[i]));
+        }
+
+        pthread_mutex_lock(&formatadores->bloqueio);
+        formatadores->textos[indice] = saida.buffer;
+        formatadores->tamanhos[indice] = saida.tamanho;
+        if (--formatadores->numPendentes == 0) pthread_cond_signal(&formatadores->fim);
+    }
+    pthread_mutex_unlock(&formatadores->bloqueio);
+    liberta_saida(&saida);
+    return NULL;
+}
+
+/**
+ * @brief Starts the threads that help the listings format their
+ * inoculations.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param numFios Number of threads besides the one of each listing.
+ * 
+ * @return 1 if successful, 0 if there is no memory or a thread cannot
+ * start, in which case the listings format alone.
+ */
+int inicia_formatadores(Sistema *sistema, int numFios) {
+    Formatadores *formatadores = &sistema->formatadores;
+    formatadores->capacidadePosicoes = (numFios + 1) * FATIA_LISTAGEM;
+    formatadores->fios = (pthread_t *)malloc(numFios * sizeof(pthread_t));
+    formatadores->posicoes = (int *)malloc(formatadores->capacidadePosicoes * sizeof(int));
+    formatadores->textos = (char **)malloc(numFios * sizeof(char *));
+    formatadores->tamanhos = (int *)malloc(numFios * sizeof(int));
+    if (formatadores->fios == NULL || formatadores->posicoes == NULL ||
+        formatadores->textos == NULL || formatadores->tamanhos == NULL) {
+        liberta_formatadores(sistema);
+        return 0;
+    }
+    pthread_mutex_init(&formatadores->bloqueio, NULL);
+    pthread_mutex_init(&formatadores->ocupados, NULL);
+    pthread_cond_init(&formatadores->inicio, NULL);
+    pthread_cond_init(&formatadores->fim, NULL);
+    for (; formatadores->numFios < numFios; formatadores->numFios++) {
+        if (pthread_create(&formatadores->fios[formatadores->numFios], NULL, formata,
+                           sistema) != 0) {
+            liberta_formatadores(sistema);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Takes the threads that format for a listing, if they are free.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * 
+ * @return The array where the listing collects the positions of each
+ * round, up to capacidadePosicoes, or NULL if there are no threads or
+ * another listing has them, in which case the listing formats alone.
+ */
+int *reserva_formatadores(Sistema *sistema) {
+    Formatadores *formatadores = &sistema->formatadores;
+    if (formatadores->numFios == 0 || pthread_mutex_trylock(&formatadores->ocupados) != 0) {
+        return NULL;
+    }
+    return formatadores->posicoes;
+}
+
+/**
+ * @brief Formats a round of inoculations of a listing, split among its
+ * threads, and writes them in order.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param saida Output where the inoculations are written.
+ * @param numPosicoes Number of positions collected in the round.
+ * 
+ * @note A small round is formatted by the thread of the listing alone,
+ * since waking the other threads would take longer.
+ */
+void formata_inoculacoes(Sistema *sistema, Saida *saida, int numPosicoes) {
+    Formatadores *formatadores = &sistema->formatadores;
+    int fim = numPosicoes;
+    if (numPosicoes >= MIN_LISTAGEM_PARALELA) {
+        pthread_mutex_lock(&formatadores->bloqueio);
+        formatadores->numPosicoes = numPosicoes;
+        formatadores->numPendentes = formatadores->numFios;
+        formatadores->ronda++;
+        pthread_cond_broadcast(&formatadores->inicio);
+        pthread_mutex_unlock(&formatadores->bloqueio);
+        fim = numPosicoes / (formatadores->numFios + 1);
+    }
+    for (int i = 0; i < fim; i++) {
+        escreve_inoculacao(saida, sistema, obtem_inoculacao(sistema, formatadores->posicoes[i]));
+    }
+    if (fim == numPosicoes) return;
+
+    pthread_mutex_lock(&formatadores->bloqueio);
+    while (formatadores->numPendentes > 0) {
+        pthread_cond_wait(&formatadores->fim, &formatadores->bloqueio);
+    }
+    pthread_mutex_unlock(&formatadores->bloqueio);
+    for (int i = 0; i < formatadores->numFios; i++) {
+        escreve_bytes(saida, formatadores->textos[i], formatadores->tamanhos[i]);
+    }
+}
+
+/**
+ * @brief Gives back the threads that format, once the listing ends.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ */
+void devolve_formatadores(Sistema *sistema) {
+    pthread_mutex_unlock(&sistema->formatadores.ocupados);
+}
+
+/**
+ * @brief Stops the threads that format and frees their memory.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ */
+void liberta_formatadores(Sistema *sistema) {
+    Formatadores *formatadores = &sistema->formatadores;
+    if (formatadores->numFios > 0) {
+        pthread_mutex_lock(&formatadores->bloqueio);
+        formatadores->parar = 1;
+        pthread_cond_broadcast(&formatadores->inicio);
+        pthread_mutex_unlock(&formatadores->bloqueio);
+        for (int i = 0; i < formatadores->numFios; i++) {
+            pthread_join(formatadores->fios[i], NULL);
+        }
+        pthread_mutex_destroy(&formatadores->bloqueio);
+        pthread_mutex_destroy(&formatadores->ocupados);
+        pthread_cond_destroy(&formatadores->inicio);
+        pthread_cond_destroy(&formatadores->fim);
+    }
+    free(formatadores->fios);
+    free(formatadores->posicoes);
+    free(formatadores->textos);
+    free(formatadores->tamanhos);
+    memset(formatadores, 0, sizeof(Formatadores));
+}
@@ -0,0 +1,30 @@
+/**
+ * Declarations for the threads that help format the large listings
+ * of the vaccination system.
+ * @file: format_func.h
+ * @author: ist1114613 (João Tamagnini)
+ */
+#ifndef FORMAT_FUNC_H
+#define FORMAT_FUNC_H
+#include "headers.h"
+
+/// @defgroup format_funcs Formatting functions.
+/// @{
+
+/// Starts the threads that help the listings format their inoculations.
+int inicia_formatadores(Sistema *sistema, int numFios);
+
+/// Takes the threads that format for a listing, if they are free.
+int *reserva_formatadores(Sistema *sistema);
+
+/// Formats a round of inoculations of a listing, split among its threads.
+void formata_inoculacoes(Sistema *sistema, Saida *saida, int numPosicoes);
+
+/// Gives back the threads that format, once the listing ends.
+void devolve_formatadores(Sistema *sistema);
+
+/// Stops the threads that format and frees their memory.
+void liberta_formatadores(Sistema *sistema);
+
+/// @}
+#endif
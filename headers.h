@@ -1,23 +1,39 @@
-/** 
-* A file to include all the headers needed for the project 
-* @file headers.h
-* @author: ist1114613 (João Tamagnini)
-*/
-
-#ifndef HEADERS
-#define HEADERS
-
-/** Includes from libraries. */ 
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include <ctype.h>
-
-/** Includes from project files. */
-#include "constants.h"
-#include "structures.h"
-#include "error_func.h"
-#include "auxiliary_func.h"
-#include "commands.h"
-
+/** 
+* A file to include all the headers needed for the project 
+* @file headers.h
+* @author: ist1114613 (João Tamagnini)
+*/
+
+#ifndef HEADERS
+#define HEADERS
+
+/** Includes from libraries. */ 
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <unistd.h>
+#include <errno.h>
+#include <pthread.h>
+
+/** Includes from project files. */
+#include "constants.h"
+#include "structures.h"
+#include "error_func.h"
+#include "auxiliary_func.h"
+#include "index_func.h"
+#include "storage_func.h"
+#include "lock_func.h"
+#include "version_func.h"
+#include "date_func.h"
+#include "io_func.h"
+#include "snapshot_func.h"
+#include "journal_func.h"
+#include "stats_func.h"
+#include "memory_func.h"
+#include "server_func.h"
+#include "pipeline_func.h"
+#include "format_func.h"
+#include "commands.h"
+
 #endif
\ No newline at end of file
@@ -0,0 +1,708 @@
+/**
+ * Implementation of the hash indexes used to speed up
+ * lookups in the vaccination system.
+ * @file: index_func.c
+ * @author: ist1114613 (João Tamagnini)
+ */
+#include "headers.h"
+
+/**
+ * @brief Computes the hash of a string (FNV-1a).
+ * 
+ * @param str String to hash.
+ * 
+ * @return The hash value of the string.
+ */
+unsigned int hash_string(const char *str) {
+    unsigned int hash = 2166136261u;
+    while (*str) {
+        hash ^= (unsigned char)*str++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Gets the slot of a batch from its batch number.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param lote Batch number.
+ * 
+ * @return The slot of the batch in the system, -1 if it does not exist.
+ */
+int procura_lote(Sistema *sistema, const char *lote) {
+    return procura_nome(&sistema->indiceLotes, lote);
+}
+
+/**
+ * @brief Adds the batch in the given slot to the batch number index.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param slot Slot of the batch in the system.
+ * 
+ * @return 1 if successful, 0 if there is no memory.
+ */
+int insere_indice_lote(Sistema *sistema, int slot) {
+    return insere_nome(&sistema->indiceLotes, obtem_lote(sistema, slot)->lote, slot);
+}
+
+/**
+ * @brief Removes a batch number from the batch number index.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param lote Batch number.
+ */
+void remove_indice_lote(Sistema *sistema, const char *lote) {
+    remove_nome(&sistema->indiceLotes, lote);
+}
+
+/**
+ * @brief Compares two batches by expiration date and then by batch number.
+ * 
+ * @param lote1 Pointer to the first batch.
+ * @param lote2 Pointer to the second batch.
+ * 
+ * @return A negative value if lote1 comes first, positive if lote2 comes
+ * first and 0 if they are the same batch.
+ */
+int compara_lotes(const Lote *lote1, const Lote *lote2) {
+    if (lote1->data != lote2->data) return lote1->data < lote2->data ? -1 : 1;
+    return strcmp(lote1->lote, lote2->lote);
+}
+
+/**
+ * @brief Gets the position of a batch in the sorted order using binary search.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param slot Slot of the batch in the system.
+ * @param total Number of batches in the sorted order.
+ * 
+ * @return The position of the batch, or the position where it
+ * should be inserted.
+ */
+static int posicao_ordem_lote(Sistema *sistema, int slot, int total) {
+    int inicio = 0, fim = total;
+    while (inicio < fim) {
+        int meio = (inicio + fim) / 2;
+        if (compara_lotes(obtem_lote(sistema, sistema->ordemLotes[meio]),
+                          obtem_lote(sistema, slot)) < 0) {
+            inicio = meio + 1;
+        } else {
+            fim = meio;
+        }
+    }
+    return inicio;
+}
+
+/**
+ * @brief Adds a batch to the sorted order of batches.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param slot Slot of the batch in the system.
+ * 
+ * @note The batch must already be counted in numLotes, so the sorted
+ * order holds numLotes - 1 batches before the insertion.
+ */
+void insere_ordem_lote(Sistema *sistema, int slot) {
+    int total = sistema->numLotes - 1;
+    int pos = posicao_ordem_lote(sistema, slot, total);
+    memmove(&sistema->ordemLotes[pos + 1], &sistema->ordemLotes[pos],
+            (total - pos) * sizeof(int));
+    sistema->ordemLotes[pos] = slot;
+}
+
+/**
+ * @brief Removes a batch from the sorted order of batches.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param slot Slot of the batch in the system.
+ * 
+ * @note The batch must still be counted in numLotes, so the sorted
+ * order holds numLotes - 1 batches after the removal.
+ */
+void remove_ordem_lote(Sistema *sistema, int slot) {
+    int total = sistema->numLotes;
+    int pos = posicao_ordem_lote(sistema, slot, total);
+    memmove(&sistema->ordemLotes[pos], &sistema->ordemLotes[pos + 1],
+            (total - pos - 1) * sizeof(int));
+}
+
+/**
+ * @brief Initializes an empty name index.
+ * 
+ * @param indice Pointer to the name index.
+ * @param capacidade Number of positions of the index (power of two).
+ * 
+ * @return 1 if successful, 0 if there is no memory.
+ */
+int inicia_indice_nomes(IndiceNomes *indice, int capacidade) {
+    indice->nomes = (const char **)calloc(capacidade, sizeof(const char *));
+    indice->ids = (int *)malloc(capacidade * sizeof(int));
+    if (indice->nomes == NULL || indice->ids == NULL) {
+        free(indice->nomes);
+        free(indice->ids);
+        indice->nomes = NULL;
+        indice->ids = NULL;
+        indice->capacidade = indice->tamanho = 0;
+        return 0;
+    }
+    indice->capacidade = capacidade;
+    indice->tamanho = 0;
+    return 1;
+}
+
+/**
+ * @brief Gets the position in the name index of a name whose hash
+ * is already known.
+ * 
+ * @param indice Pointer to the name index.
+ * @param nome Name to look for.
+ * @param hash Hash of the name.
+ * 
+ * @return The position holding the name, or the empty
+ * position where it would be inserted.
+ */
+static int posicao_hash(const IndiceNomes *indice, const char *nome, unsigned int hash) {
+    int mascara = indice->capacidade - 1;
+    int pos = hash & mascara;
+    while (indice->nomes[pos] != NULL && strcmp(indice->nomes[pos], nome) != 0) {
+        pos = (pos + 1) & mascara;
+    }
+    return pos;
+}
+
+/**
+ * @brief Gets the position in the name index of a name.
+ * 
+ * @param indice Pointer to the name index.
+ * @param nome Name to look for.
+ * 
+ * @return The position holding the name, or the empty
+ * position where it would be inserted.
+ */
+static int posicao_indice_nomes(const IndiceNomes *indice, const char *nome) {
+    return posicao_hash(indice, nome, hash_string(nome));
+}
+
+/**
+ * @brief Gets the id associated with a name.
+ * 
+ * @param indice Pointer to the name index.
+ * @param nome Name to look for.
+ * 
+ * @return The id of the name, -1 if it is not in the index.
+ */
+int procura_nome(const IndiceNomes *indice, const char *nome) {
+    if (indice->capacidade == 0) return -1;
+    int pos = posicao_indice_nomes(indice, nome);
+    return indice->nomes[pos] == NULL ? -1 : indice->ids[pos];
+}
+
+/**
+ * @brief Adds a name to the name index, doubling it when half full.
+ * 
+ * @param indice Pointer to the name index.
+ * @param nome Name to add, which must stay valid while it is in the index.
+ * @param id Id associated with the name.
+ * 
+ * @return 1 if successful, 0 if there is no memory.
+ */
+int insere_nome(IndiceNomes *indice, const char *nome, int id) {
+    if (2 * (indice->tamanho + 1) > indice->capacidade) {
+        IndiceNomes novo;
+        int capacidade = indice->capacidade ? 2 * indice->capacidade : TAM_INICIAL_INDICE;
+        if (!inicia_indice_nomes(&novo, capacidade)) return 0;
+        for (int i = 0; i < indice->capacidade; i++) {
+            if (indice->nomes[i] != NULL) {
+                int pos = posicao_indice_nomes(&novo, indice->nomes[i]);
+                novo.nomes[pos] = indice->nomes[i];
+                novo.ids[pos] = indice->ids[i];
+            }
+        }
+        novo.tamanho = indice->tamanho;
+        liberta_indice_nomes(indice);
+        *indice = novo;
+    }
+    int pos = posicao_indice_nomes(indice, nome);
+    indice->nomes[pos] = nome;
+    indice->ids[pos] = id;
+    indice->tamanho++;
+    return 1;
+}
+
+/**
+ * @brief Removes a name from the name index.
+ * 
+ * @param indice Pointer to the name index.
+ * @param nome Name to remove.
+ * 
+ * @note Uses backward shift deletion so that no tombstones are needed.
+ */
+void remove_nome(IndiceNomes *indice, const char *nome) {
+    if (indice->capacidade == 0) return;
+    int mascara = indice->capacidade - 1;
+    int vazio = posicao_indice_nomes(indice, nome);
+    if (indice->nomes[vazio] == NULL) return;
+
+    // Move back the following names that would no longer be reachable.
+    int seguinte = (vazio + 1) & mascara;
+    while (indice->nomes[seguinte] != NULL) {
+        int ideal = hash_string(indice->nomes[seguinte]) & mascara;
+        if (((seguinte - ideal) & mascara) >= ((seguinte - vazio) & mascara)) {
+            indice->nomes[vazio] = indice->nomes[seguinte];
+            indice->ids[vazio] = indice->ids[seguinte];
+            vazio = seguinte;
+        }
+        seguinte = (seguinte + 1) & mascara;
+    }
+    indice->nomes[vazio] = NULL;
+    indice->tamanho--;
+}
+
+/**
+ * @brief Frees the memory allocated for a name index.
+ * 
+ * @param indice Pointer to the name index.
+ */
+void liberta_indice_nomes(IndiceNomes *indice) {
+    free(indice->nomes);
+    free(indice->ids);
+    indice->nomes = NULL;
+    indice->ids = NULL;
+    indice->capacidade = indice->tamanho = 0;
+}
+
+/**
+ * @brief Gets the id of a vaccine, registering it if it is new.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param nome Name of the vaccine.
+ * 
+ * @return The id of the vaccine, -1 if there is no memory.
+ */
+int regista_vacina(Sistema *sistema, const char *nome) {
+    int id = procura_nome(&sistema->indiceVacinas, nome);
+    if (id != -1) return id;
+
+    // Make room for the new vaccine.
+    if (sistema->numVacinas == sistema->capacidadeVacinas) {
+        int capacidade = sistema->capacidadeVacinas ? 2 * sistema->capacidadeVacinas : 16;
+        Vacina *novas = (Vacina *)realloc(sistema->vacinas, capacidade * sizeof(Vacina));
+        if (novas == NULL) return -1;
+        sistema->vacinas = novas;
+        sistema->capacidadeVacinas = capacidade;
+    }
+
+    // Register the vaccine with an empty heap of batches.
+    Vacina *vacina = &sistema->vacinas[sistema->numVacinas];
+    vacina->nome = guarda_nome(&sistema->nomes, nome);
+    vacina->heap = (int *)malloc(CAP_INICIAL_HEAP * sizeof(int));
+    if (vacina->nome == NULL || vacina->heap == NULL ||
+        !insere_nome(&sistema->indiceVacinas, vacina->nome, sistema->numVacinas)) {
+        free(vacina->heap);
+        return -1;
+    }
+    vacina->tamanhoHeap = 0;
+    vacina->capacidadeHeap = CAP_INICIAL_HEAP;
+    return sistema->numVacinas++;
+}
+
+/**
+ * @brief Places a batch in a position of the heap of its vaccine.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param vacina Pointer to the vaccine.
+ * @param pos Position in the heap.
+ * @param slot Slot of the batch in the system.
+ */
+static void coloca_heap(Sistema *sistema, Vacina *vacina, int pos, int slot) {
+    vacina->heap[pos] = slot;
+    obtem_lote(sistema, slot)->posHeap = pos;
+}
+
+/**
+ * @brief Moves a batch of the heap up or down until the heap
+ * is ordered again.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param vacina Pointer to the vaccine.
+ * @param pos Position of the batch in the heap.
+ */
+static void corrige_heap(Sistema *sistema, Vacina *vacina, int pos) {
+    int slot = vacina->heap[pos];
+
+    // Move the batch up while it expires before its parent.
+    while (pos > 0 && compara_lotes(obtem_lote(sistema, slot),
+                      obtem_lote(sistema, vacina->heap[(pos - 1) / 2])) < 0) {
+        coloca_heap(sistema, vacina, pos, vacina->heap[(pos - 1) / 2]);
+        pos = (pos - 1) / 2;
+    }
+
+    // Move the batch down while one of its children expires before it.
+    while (2 * pos + 1 < vacina->tamanhoHeap) {
+        int filho = 2 * pos + 1;
+        if (filho + 1 < vacina->tamanhoHeap &&
+            compara_lotes(obtem_lote(sistema, vacina->heap[filho + 1]),
+                          obtem_lote(sistema, vacina->heap[filho])) < 0) {
+            filho++;
+        }
+        if (compara_lotes(obtem_lote(sistema, vacina->heap[filho]),
+                          obtem_lote(sistema, slot)) >= 0) {
+            break;
+        }
+        coloca_heap(sistema, vacina, pos, vacina->heap[filho]);
+        pos = filho;
+    }
+    coloca_heap(sistema, vacina, pos, slot);
+}
+
+/**
+ * @brief Makes room for one more batch in the heap of batches with stock
+ * of the vaccine of a batch, so adding it afterwards cannot fail.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param slot Slot of the batch in the system.
+ * 
+ * @return 1 if successful, 0 if there is no memory.
+ */
+int reserva_heap_lote(Sistema *sistema, int slot) {
+    Vacina *vacina = &sistema->vacinas[obtem_lote(sistema, slot)->vacina];
+    if (vacina->tamanhoHeap == vacina->capacidadeHeap) {
+        int *novo = (int *)realloc(vacina->heap, 2 * vacina->capacidadeHeap * sizeof(int));
+        if (novo == NULL) return 0;
+        vacina->heap = novo;
+        vacina->capacidadeHeap *= 2;
+    }
+    return 1;
+}
+
+/**
+ * @brief Adds a batch to the heap of batches with stock of its vaccine.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param slot Slot of the batch in the system.
+ * 
+ * @return 1 if successful, 0 if there is no memory.
+ */
+int insere_heap_lote(Sistema *sistema, int slot) {
+    if (!reserva_heap_lote(sistema, slot)) return 0;
+    Vacina *vacina = &sistema->vacinas[obtem_lote(sistema, slot)->vacina];
+    coloca_heap(sistema, vacina, vacina->tamanhoHeap++, slot);
+    corrige_heap(sistema, vacina, vacina->tamanhoHeap - 1);
+    return 1;
+}
+
+/**
+ * @brief Removes a batch from the heap of batches with stock of its vaccine.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param slot Slot of the batch in the system.
+ * 
+ * @note Does nothing if the batch is not in the heap.
+ */
+void remove_heap_lote(Sistema *sistema, int slot) {
+    Lote *lote = obtem_lote(sistema, slot);
+    int pos = lote->posHeap;
+    if (pos == -1) return;
+    Vacina *vacina = &sistema->vacinas[lote->vacina];
+    lote->posHeap = -1;
+
+    // Replace the batch with the last one of the heap.
+    int ultimo = vacina->heap[--vacina->tamanhoHeap];
+    if (pos < vacina->tamanhoHeap) {
+        coloca_heap(sistema, vacina, pos, ultimo);
+        corrige_heap(sistema, vacina, pos);
+    }
+}
+
+/**
+ * @brief Updates the position of a batch in its heap after its
+ * expiration date changed.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param slot Slot of the batch in the system.
+ */
+void atualiza_heap_lote(Sistema *sistema, int slot) {
+    Lote *lote = obtem_lote(sistema, slot);
+    if (lote->posHeap != -1) {
+        corrige_heap(sistema, &sistema->vacinas[lote->vacina], lote->posHeap);
+    }
+}
+
+/**
+ * @brief Removes the expired batches from the heaps of all vaccines.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * 
+ * @note Since the heaps are ordered by expiration date, only the 
+ * batches on the top of each heap have to be checked.
+ */
+void remove_lotes_expirados(Sistema *sistema) {
+    for (int i = 0; i < sistema->numVacinas; i++) {
+        Vacina *vacina = &sistema->vacinas[i];
+        while (vacina->tamanhoHeap > 0) {
+            Lote *lote = obtem_lote(sistema, vacina->heap[0]);
+            if (datavalidaNein(lote->data, sistema)) break;
+            remove_heap_lote(sistema, vacina->heap[0]);
+        }
+    }
+}
+
+/**
+ * @brief Gets the shard of a user from its name. The shard comes from
+ * the highest bits of the hash, so the lowest bits, which place the
+ * name in the index of the shard, stay spread.
+ * 
+ * @param nome Name of the user.
+ * 
+ * @return The number of the shard.
+ */
+int fatia_utente(const char *nome) {
+    return (int)(hash_string(nome) >> (32 - BITS_FATIAS));
+}
+
+/**
+ * @brief Gets the id of a user from its name, hashing the name only
+ * once for its shard and for its position in the index of the shard.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param nome Name of the user.
+ * 
+ * @return The id of the user, -1 if it does not exist.
+ */
+int procura_utente(Sistema *sistema, const char *nome) {
+    unsigned int hash = hash_string(nome);
+    int fatia = (int)(hash >> (32 - BITS_FATIAS));
+    const IndiceNomes *indice = &sistema->fatiasUtentes[fatia].indice;
+    if (indice->capacidade == 0) return -1;
+    int pos = posicao_hash(indice, nome, hash);
+    return indice->nomes[pos] == NULL ? -1 : (indice->ids[pos] << BITS_FATIAS) | fatia;
+}
+
+/**
+ * @brief Gets the id of a user, registering it if it is new. The id
+ * keeps the shard of the user in its lowest bits and the position of
+ * the user in the shard in the others.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param nome Name of the user.
+ * 
+ * @return The id of the user, -1 if there is no memory.
+ */
+int regista_utente(Sistema *sistema, const char *nome) {
+    int id = procura_utente(sistema, nome);
+    if (id != -1) return id;
+    int numero = fatia_utente(nome);
+    FatiaUtentes *fatia = &sistema->fatiasUtentes[numero];
+
+    // Make room for the new user, copying the users that listings may be reading.
+    if (fatia->numUtentes == fatia->capacidadeUtentes) {
+        int capacidade = fatia->capacidadeUtentes ? 2 * fatia->capacidadeUtentes : 16;
+        if (!cresce_memoria(sistema, (void **)&fatia->utentes,
+                            fatia->numUtentes * sizeof(Utente), capacidade * sizeof(Utente))) {
+            return -1;
+        }
+        fatia->capacidadeUtentes = capacidade;
+    }
+
+    // Register the user without inoculations.
+    Utente *utente = &fatia->utentes[fatia->numUtentes];
+    utente->nome = guarda_nome(&fatia->nomes, nome);
+    utente->inoculacoes = (int *)malloc(CAP_INICIAL_UTENTE * sizeof(int));
+    if (utente->nome == NULL || utente->inoculacoes == NULL ||
+        !insere_nome(&fatia->indice, utente->nome, fatia->numUtentes)) {
+        free(utente->inoculacoes);
+        return -1;
+    }
+    utente->numInoculacoes = 0;
+    utente->capacidadeInoculacoes = CAP_INICIAL_UTENTE;
+    return (fatia->numUtentes++ << BITS_FATIAS) | numero;
+}
+
+/**
+ * @brief Makes room in the list of a user for one more inoculation.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param utente Id of the user.
+ * 
+ * @return 1 if successful, 0 if there is no memory.
+ */
+int reserva_inoculacao_utente(Sistema *sistema, int utente) {
+    Utente *u = obtem_utente(sistema, utente);
+    if (u->numInoculacoes == u->capacidadeInoculacoes) {
+        int *novas = (int *)realloc(u->inoculacoes,
+                                    2 * u->capacidadeInoculacoes * sizeof(int));
+        if (novas == NULL) return 0;
+        u->inoculacoes = novas;
+        u->capacidadeInoculacoes *= 2;
+    }
+    return 1;
+}
+
+/**
+ * @brief Adds the position of an inoculation to the list of its user.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param utente Id of the user.
+ * @param pos Position of the inoculation in the system.
+ * 
+ * @return 1 if successful, 0 if there is no memory.
+ */
+int adiciona_inoculacao_utente(Sistema *sistema, int utente, int pos) {
+    if (!reserva_inoculacao_utente(sistema, utente)) return 0;
+    Utente *u = obtem_utente(sistema, utente);
+    u->inoculacoes[u->numInoculacoes++] = pos;
+    return 1;
+}
+
+/**
+ * @brief Rebuilds the lists of inoculations of all users, following
+ * the inoculations in the order they were added.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * 
+ * @note The lists must already have room for all the inoculations
+ * of their users, so they do not need to grow.
+ */
+void reconstroi_inoculacoes_utentes(Sistema *sistema) {
+    for (int f = 0; f < NUM_FATIAS; f++) {
+        FatiaUtentes *fatia = &sistema->fatiasUtentes[f];
+        for (int i = 0; i < fatia->numUtentes; i++) {
+            fatia->utentes[i].numInoculacoes = 0;
+        }
+    }
+    for (int i = sistema->primeiraInoculacao; i != -1; ) {
+        Inoculacao *inoculacao = obtem_inoculacao(sistema, i);
+        Utente *u = obtem_utente(sistema, inoculacao->utente);
+        u->inoculacoes[u->numInoculacoes++] = i;
+        i = inoculacao->seguinte;
+    }
+}
+
+/**
+ * @brief Computes the hash of the key of a vaccination.
+ * 
+ * @param chave Pointer to the key of the vaccination.
+ * 
+ * @return The hash value of the key.
+ */
+static unsigned int hash_vacinacao(const ChaveVacinacao *chave) {
+    unsigned int hash = 2166136261u;
+    int campos[] = { chave->utente, chave->vacina, chave->data };
+    for (int i = 0; i < 3; i++) {
+        hash ^= (unsigned int)campos[i];
+        hash *= 16777619u;
+        hash ^= hash >> 15;
+    }
+    return hash;
+}
+
+/**
+ * @brief Gets the position in the set of the key of a vaccination.
+ * 
+ * @param conjunto Pointer to the set of vaccinations.
+ * @param chave Pointer to the key of the vaccination.
+ * 
+ * @return The position holding the key, or the empty position
+ * where it would be inserted.
+ */
+static int posicao_vacinacao(const ConjuntoVacinacoes *conjunto,
+                             const ChaveVacinacao *chave) {
+    int mascara = conjunto->capacidade - 1;
+    int pos = hash_vacinacao(chave) & mascara;
+    while (conjunto->chaves[pos].utente != -1 &&
+           (conjunto->chaves[pos].utente != chave->utente ||
+            conjunto->chaves[pos].vacina != chave->vacina ||
+            conjunto->chaves[pos].data != chave->data)) {
+        pos = (pos + 1) & mascara;
+    }
+    return pos;
+}
+
+/**
+ * @brief Checks if a vaccination is in the set of vaccinations.
+ * 
+ * @param conjunto Pointer to the set of vaccinations.
+ * @param chave Pointer to the key of the vaccination.
+ * 
+ * @return 1 if the vaccination is in the set, 0 otherwise.
+ */
+int contem_vacinacao(const ConjuntoVacinacoes *conjunto, const ChaveVacinacao *chave) {
+    if (conjunto->capacidade == 0) return 0;
+    return conjunto->chaves[posicao_vacinacao(conjunto, chave)].utente != -1;
+}
+
+/**
+ * @brief Adds a vaccination to the set of vaccinations, doubling 
+ * the set when half full.
+ * 
+ * @param conjunto Pointer to the set of vaccinations.
+ * @param chave Pointer to the key of the vaccination.
+ * 
+ * @return 1 if successful, 0 if there is no memory.
+ */
+int insere_vacinacao(ConjuntoVacinacoes *conjunto, const ChaveVacinacao *chave) {
+    if (2 * (conjunto->tamanho + 1) > conjunto->capacidade) {
+        ConjuntoVacinacoes novo;
+        novo.capacidade = conjunto->capacidade ? 2 * conjunto->capacidade : TAM_INICIAL_INDICE;
+        novo.tamanho = conjunto->tamanho;
+        novo.chaves = (ChaveVacinacao *)malloc(novo.capacidade * sizeof(ChaveVacinacao));
+        if (novo.chaves == NULL) return 0;
+        for (int i = 0; i < novo.capacidade; i++) {
+            novo.chaves[i].utente = -1;
+        }
+        for (int i = 0; i < conjunto->capacidade; i++) {
+            if (conjunto->chaves[i].utente != -1) {
+                novo.chaves[posicao_vacinacao(&novo, &conjunto->chaves[i])] =
+                    conjunto->chaves[i];
+            }
+        }
+        free(conjunto->chaves);
+        *conjunto = novo;
+    }
+    int pos = posicao_vacinacao(conjunto, chave);
+    if (conjunto->chaves[pos].utente == -1) {
+        conjunto->chaves[pos] = *chave;
+        conjunto->tamanho++;
+    }
+    return 1;
+}
+
+/**
+ * @brief Removes a vaccination from the set of vaccinations.
+ * 
+ * @param conjunto Pointer to the set of vaccinations.
+ * @param chave Pointer to the key of the vaccination.
+ * 
+ * @note Uses backward shift deletion so that no tombstones are needed.
+ */
+void remove_vacinacao(ConjuntoVacinacoes *conjunto, const ChaveVacinacao *chave) {
+    if (conjunto->capacidade == 0) return;
+    int mascara = conjunto->capacidade - 1;
+    int vazio = posicao_vacinacao(conjunto, chave);
+    if (conjunto->chaves[vazio].utente == -1) return;
+
+    // Move back the following keys that would no longer be reachable.
+    int seguinte = (vazio + 1) & mascara;
+    while (conjunto->chaves[seguinte].utente != -1) {
+        int ideal = hash_vacinacao(&conjunto->chaves[seguinte]) & mascara;
+        if (((seguinte - ideal) & mascara) >= ((seguinte - vazio) & mascara)) {
+            conjunto->chaves[vazio] = conjunto->chaves[seguinte];
+            vazio = seguinte;
+        }
+        seguinte = (seguinte + 1) & mascara;
+    }
+    conjunto->chaves[vazio].utente = -1;
+    conjunto->tamanho--;
+}
+
+/**
+ * @brief Frees the memory allocated for a set of vaccinations.
+ * 
+ * @param conjunto Pointer to the set of vaccinations.
+ */
+void liberta_vacinacoes(ConjuntoVacinacoes *conjunto) {
+    free(conjunto->chaves);
+    conjunto->chaves = NULL;
+    conjunto->capacidade = conjunto->tamanho = 0;
+}
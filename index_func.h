@@ -0,0 +1,99 @@
+/**
+ * Declarations for the hash indexes used to speed up
+ * lookups in the vaccination system.
+ * @file: index_func.h
+ * @author: ist1114613 (João Tamagnini)
+ */
+#ifndef INDEX_FUNC_H
+#define INDEX_FUNC_H
+#include "headers.h"
+
+/// @defgroup index_funcs Index functions.
+/// @{
+
+/// Computes the hash of a string.
+unsigned int hash_string(const char *str);
+
+/// Gets the slot of a batch from its batch number.
+int procura_lote(Sistema *sistema, const char *lote);
+
+/// Adds the batch in the given slot to the batch number index.
+int insere_indice_lote(Sistema *sistema, int slot);
+
+/// Removes a batch number from the batch number index.
+void remove_indice_lote(Sistema *sistema, const char *lote);
+
+/// Compares two batches by expiration date and then by batch number.
+int compara_lotes(const Lote *lote1, const Lote *lote2);
+
+/// Adds a batch to the sorted order of batches.
+void insere_ordem_lote(Sistema *sistema, int slot);
+
+/// Removes a batch from the sorted order of batches.
+void remove_ordem_lote(Sistema *sistema, int slot);
+
+/// Initializes an empty name index.
+int inicia_indice_nomes(IndiceNomes *indice, int capacidade);
+
+/// Gets the id associated with a name.
+int procura_nome(const IndiceNomes *indice, const char *nome);
+
+/// Adds a name to the name index.
+int insere_nome(IndiceNomes *indice, const char *nome, int id);
+
+/// Removes a name from the name index.
+void remove_nome(IndiceNomes *indice, const char *nome);
+
+/// Frees the memory allocated for a name index.
+void liberta_indice_nomes(IndiceNomes *indice);
+
+/// Gets the id of a vaccine, registering it if it is new.
+int regista_vacina(Sistema *sistema, const char *nome);
+
+/// Adds a batch to the heap of batches with stock of its vaccine.
+int insere_heap_lote(Sistema *sistema, int slot);
+
+/// Makes room for a batch in the heap of batches with stock of its vaccine.
+int reserva_heap_lote(Sistema *sistema, int slot);
+
+/// Removes a batch from the heap of batches with stock of its vaccine.
+void remove_heap_lote(Sistema *sistema, int slot);
+
+/// Updates the position of a batch in its heap after its date changed.
+void atualiza_heap_lote(Sistema *sistema, int slot);
+
+/// Removes the expired batches from the heaps of all vaccines.
+void remove_lotes_expirados(Sistema *sistema);
+
+/// Gets the shard of a user from its name.
+int fatia_utente(const char *nome);
+
+/// Gets the id of a user from its name.
+int procura_utente(Sistema *sistema, const char *nome);
+
+/// Gets the id of a user, registering it if it is new.
+int regista_utente(Sistema *sistema, const char *nome);
+
+/// Makes room in the list of a user for one more inoculation.
+int reserva_inoculacao_utente(Sistema *sistema, int utente);
+
+/// Adds the position of an inoculation to the list of its user.
+int adiciona_inoculacao_utente(Sistema *sistema, int utente, int pos);
+
+/// Rebuilds the lists of inoculations of all users.
+void reconstroi_inoculacoes_utentes(Sistema *sistema);
+
+/// Checks if a vaccination is in the set of vaccinations.
+int contem_vacinacao(const ConjuntoVacinacoes *conjunto, const ChaveVacinacao *chave);
+
+/// Adds a vaccination to the set of vaccinations.
+int insere_vacinacao(ConjuntoVacinacoes *conjunto, const ChaveVacinacao *chave);
+
+/// Removes a vaccination from the set of vaccinations.
+void remove_vacinacao(ConjuntoVacinacoes *conjunto, const ChaveVacinacao *chave);
+
+/// Frees the memory allocated for a set of vaccinations.
+void liberta_vacinacoes(ConjuntoVacinacoes *conjunto);
+
+/// @}
+#endif
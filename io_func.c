@@ -0,0 +1,475 @@
+/**
+ * Implementation of the reading and parsing of the commands
+ * of the vaccination system.
+ * 
+ * The input is read in large blocks into the buffer of a reader and
+ * the lines are split in place, so the parameters of a command point
+ * into that buffer until the next command is read. The output is kept
+ * in the buffer of an output and written in large blocks.
+ * @file: io_func.c
+ * @author: ist1114613 (João Tamagnini)
+ */
+#include "headers.h"
+
+/**
+ * @brief Initializes a reader of commands from a file.
+ * 
+ * @param leitor Pointer to the reader.
+ * @param ficheiro File from which the commands are read.
+ * @param saida Output written before waiting for more input, or NULL.
+ * @param journal Journal written before waiting for more input, or NULL.
+ * 
+ * @return 1 if successful, 0 if there is no memory.
+ */
+int inicia_leitor(Leitor *leitor, FILE *ficheiro, Saida *saida, Journal *journal) {
+    leitor->ficheiro = ficheiro;
+    leitor->saida = saida;
+    leitor->journal = journal;
+    leitor->capacidade = TAM_BLOCO_LEITURA;
+    leitor->buffer = (char *)malloc(leitor->capacidade);
+    leitor->inicio = leitor->fim = 0;
+    leitor->fimFicheiro = 0;
+    leitor->numLeituras = 0;
+    return leitor->buffer != NULL;
+}
+
+/**
+ * @brief Reads another block of the file into the buffer, moving the
+ * unread bytes to its start and growing it when they fill it.
+ * 
+ * @param leitor Pointer to the reader.
+ * 
+ * @return The number of bytes read, 0 at the end of the file or if
+ * there is no memory to grow the buffer.
+ * 
+ * @note One byte of the buffer is always left free, so that the
+ * last line can be terminated even if it has no newline.
+ */
+static int le_bloco(Leitor *leitor) {
+    if (leitor->fimFicheiro) return 0;
+    if (leitor->inicio > 0) {
+        memmove(leitor->buffer, leitor->buffer + leitor->inicio,
+                leitor->fim - leitor->inicio);
+        leitor->fim -= leitor->inicio;
+        leitor->inicio = 0;
+    }
+    if (leitor->fim == leitor->capacidade - 1) {
+        char *buffer = (char *)realloc(leitor->buffer, 2 * leitor->capacidade);
+        if (buffer == NULL) return 0;
+        leitor->buffer = buffer;
+        leitor->capacidade *= 2;
+    }
+    /* The previous commands are written to the journal and their
+        answers to the output before waiting.*/
+    if (leitor->journal != NULL) despeja_journal(leitor->journal);
+    if (leitor->saida != NULL) despeja_saida(leitor->saida);
+    leitor->numLeituras++;
+    int lidos = (int)fread(leitor->buffer + leitor->fim, 1,
+                           leitor->capacidade - 1 - leitor->fim, leitor->ficheiro);
+    if (lidos == 0) leitor->fimFicheiro = 1;
+    leitor->fim += lidos;
+    return lidos;
+}
+
+/**
+ * @brief Reads the letter of the next command, skipping
+ * the whitespace before it.
+ * 
+ * @param leitor Pointer to the reader.
+ * 
+ * @return The letter of the command, EOF at the end of the input.
+ */
+int le_comando(Leitor *leitor) {
+    for (;;) {
+        while (leitor->inicio < leitor->fim) {
+            unsigned char c = (unsigned char)leitor->buffer[leitor->inicio++];
+            if (!isspace(c)) return c;
+        }
+        if (le_bloco(leitor) == 0) return EOF;
+    }
+}
+
+/**
+ * @brief Reads the rest of the current line, without the newline.
+ * 
+ * @param leitor Pointer to the reader.
+ * 
+ * @return The line, terminated in place in the buffer of the reader.
+ * It stays valid until the next command is read.
+ */
+char *le_linha(Leitor *leitor) {
+    int procurados = 0;
+    char *nova;
+    while ((nova = memchr(leitor->buffer + leitor->inicio + procurados, '\n',
+                          leitor->fim - leitor->inicio - procurados)) == NULL) {
+        procurados = leitor->fim - leitor->inicio;
+        if (le_bloco(leitor) == 0) {
+            // The last line may not end with a newline.
+            nova = leitor->buffer + leitor->fim;
+            break;
+        }
+    }
+    char *linha = leitor->buffer + leitor->inicio;
+    leitor->inicio = nova - leitor->buffer;
+    if (leitor->inicio < leitor->fim) leitor->inicio++;
+    *nova = '\0';
+    return linha;
+}
+
+/**
+ * @brief Checks if the next command is in the buffer of a reader,
+ * skipping the whitespace before it.
+ * 
+ * @param leitor Pointer to the reader.
+ * 
+ * @return 1 if reading the next command and its line does not wait
+ * for more input, 0 otherwise.
+ */
+int leitor_pronto(Leitor *leitor) {
+    while (leitor->inicio < leitor->fim &&
+           isspace((unsigned char)leitor->buffer[leitor->inicio])) {
+        leitor->inicio++;
+    }
+    return leitor->fimFicheiro ||
+           memchr(leitor->buffer + leitor->inicio, '\n', leitor->fim - leitor->inicio) != NULL;
+}
+
+/**
+ * @brief Frees the memory allocated for a reader.
+ * 
+ * @param leitor Pointer to the reader.
+ */
+void liberta_leitor(Leitor *leitor) {
+    free(leitor->buffer);
+    leitor->buffer = NULL;
+}
+
+/**
+ * @brief Reads the next word of a line, like the "%s" of scanf.
+ * 
+ * @param cursor Pointer to the position in the line, which is moved
+ * past the word.
+ * 
+ * @return The word, terminated in place, or NULL if there is none.
+ */
+char *proxima_palavra(char **cursor) {
+    char *palavra = *cursor;
+    while (isspace((unsigned char)*palavra)) palavra++;
+    if (*palavra == '\0') {
+        *cursor = palavra;
+        return NULL;
+    }
+    char *fim = palavra;
+    while (*fim != '\0' && !isspace((unsigned char)*fim)) fim++;
+    *cursor = *fim != '\0' ? fim + 1 : fim;
+    *fim = '\0';
+    return palavra;
+}
+
+/**
+ * @brief Reads the next integer of a line, like the "%d" of scanf.
+ * 
+ * @param cursor Pointer to the position in the line, which is moved
+ * past the integer.
+ * @param valor Pointer where the integer is stored.
+ * 
+ * @return 1 if an integer was read, 0 otherwise.
+ */
+int proximo_inteiro(char **cursor, int *valor) {
+    char *fim;
+    long numero = strtol(*cursor, &fim, 10);
+    if (fim == *cursor) return 0;
+    *valor = (int)numero;
+    *cursor = fim;
+    return 1;
+}
+
+/**
+ * @brief Reads the next date of a line, like the "%d-%d-%d" of scanf.
+ * 
+ * @param cursor Pointer to the position in the line, which is moved
+ * past the date.
+ * @param dia Pointer where the day is stored.
+ * @param mes Pointer where the month is stored.
+ * @param ano Pointer where the year is stored.
+ * 
+ * @return The number of fields of the date that were read.
+ */
+int proxima_data(char **cursor, int *dia, int *mes, int *ano) {
+    if (!proximo_inteiro(cursor, dia)) return 0;
+    if (**cursor != '-') return 1;
+    (*cursor)++;
+    if (!proximo_inteiro(cursor, mes)) return 1;
+    if (**cursor != '-') return 2;
+    (*cursor)++;
+    return proximo_inteiro(cursor, ano) ? 3 : 2;
+}
+
+/**
+ * @brief Initializes an output to a file descriptor.
+ * 
+ * @param saida Pointer to the output.
+ * @param fd File descriptor where the output is written, -1 to
+ * discard it or SAIDA_MEMORIA to keep all of it in the buffer.
+ * @param capacidade Number of bytes kept before they are written.
+ * 
+ * @return 1 if successful, 0 if there is no memory for its buffer.
+ * 
+ * @note An output without a buffer can still be used, but each
+ * write goes straight to the file descriptor. The errors are counted
+ * in the output itself until its counts are shared with another one.
+ */
+int inicia_saida(Saida *saida, int fd, int capacidade) {
+    saida->fd = fd;
+    saida->tamanho = 0;
+    saida->buffer = (char *)malloc(capacidade);
+    saida->capacidade = saida->buffer != NULL ? capacidade : 0;
+    saida->canal = NULL;
+    saida->bloco = NULL;
+    for (int i = 0; i < TAM_CACHE_DATAS; i++) {
+        saida->datas[i].data = DATA_INVALIDA;
+    }
+    for (int i = 0; i < NUM_TIPOS_ERRO; i++) {
+        saida->erros[i] = 0;
+    }
+    saida->numErros = saida->erros;
+    return saida->buffer != NULL;
+}
+
+/**
+ * @brief Writes bytes to the file descriptor of an output, retrying
+ * until all of them are written or the file descriptor would block.
+ * 
+ * @param fd File descriptor, or -1 to discard the bytes.
+ * @param bytes Bytes to write.
+ * @param tamanho Number of bytes.
+ * 
+ * @return The number of bytes written. The bytes that cannot be
+ * written because of an error are discarded and counted as written,
+ * so only a non-blocking file descriptor leaves bytes unwritten.
+ */
+static int escreve_fd(int fd, const char *bytes, int tamanho) {
+    int total = 0;
+    while (fd >= 0 && total < tamanho) {
+        ssize_t escritos = write(fd, bytes + total, tamanho - total);
+        if (escritos > 0) {
+            total += (int)escritos;
+        } else if (escritos < 0 && errno == EINTR) {
+            continue;
+        } else if (escritos < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return total;
+        } else {
+            break;
+        }
+    }
+    return tamanho;
+}
+
+/**
+ * @brief Writes the text kept by an output with a single write, or
+ * passes it to the writer of a pipeline in the block of the output,
+ * which is replaced by an empty one.
+ * 
+ * @param saida Pointer to the output.
+ * 
+ * @note If the file descriptor would block, the bytes not written
+ * are moved to the start of the buffer and kept for the next time. An
+ * output kept in memory is not written.
+ */
+void despeja_saida(Saida *saida) {
+    if (saida->fd == SAIDA_MEMORIA) return;
+    if (saida->canal != NULL) {
+        if (saida->tamanho == 0) return;
+        Bloco *bloco = saida->bloco;
+        bloco->dados = saida->buffer;
+        bloco->tamanho = saida->tamanho;
+        bloco->capacidade = saida->capacidade;
+        poe_bloco(&saida->canal->cheios, bloco);
+        saida->bloco = tira_bloco(&saida->canal->vazios);
+        saida->buffer = saida->bloco->dados;
+        saida->capacidade = saida->bloco->capacidade;
+        saida->tamanho = 0;
+        return;
+    }
+    int escritos = escreve_fd(saida->fd, saida->buffer, saida->tamanho);
+    if (escritos < saida->tamanho) {
+        memmove(saida->buffer, saida->buffer + escritos, saida->tamanho - escritos);
+    }
+    saida->tamanho -= escritos;
+}
+
+/**
+ * @brief Writes a block of output to a file descriptor.
+ * 
+ * @param fd File descriptor, or -1 to discard the block.
+ * @param bloco Pointer to the block.
+ */
+void escreve_bloco(int fd, const Bloco *bloco) {
+    escreve_fd(fd, bloco->dados, bloco->tamanho);
+}
+
+/**
+ * @brief Frees the memory allocated for an output, writing its text first.
+ * 
+ * @param saida Pointer to the output.
+ */
+void liberta_saida(Saida *saida) {
+    despeja_saida(saida);
+    free(saida->buffer);
+    saida->buffer = NULL;
+    saida->capacidade = 0;
+}
+
+/**
+ * @brief Writes bytes to an output, keeping them in its buffer.
+ * 
+ * @param saida Pointer to the output.
+ * @param bytes Bytes to write.
+ * @param tamanho Number of bytes.
+ * 
+ * @note When the file descriptor would block or the output is kept in
+ * memory, the buffer grows to keep the bytes, and they are discarded
+ * only if there is no memory.
+ */
+void escreve_bytes(Saida *saida, const char *bytes, int tamanho) {
+    if (saida->tamanho + tamanho > saida->capacidade) {
+        despeja_saida(saida);
+        /* The text of a pipeline is written in order by its writer only, and
+            an output kept in memory is never written.*/
+        if (saida->tamanho == 0 && tamanho > saida->capacidade && saida->canal == NULL &&
+            saida->fd != SAIDA_MEMORIA) {
+            int escritos = escreve_fd(saida->fd, bytes, tamanho);
+            bytes += escritos;
+            tamanho -= escritos;
+        }
+        if (saida->tamanho + tamanho > saida->capacidade) {
+            int capacidade = saida->capacidade > 0 ? saida->capacidade : tamanho;
+            while (capacidade < saida->tamanho + tamanho) capacidade *= 2;
+            char *buffer = (char *)realloc(saida->buffer, capacidade);
+            if (buffer == NULL) return;
+            saida->buffer = buffer;
+            saida->capacidade = capacidade;
+        }
+    }
+    memcpy(saida->buffer + saida->tamanho, bytes, tamanho);
+    saida->tamanho += tamanho;
+}
+
+/**
+ * @brief Writes a string to an output.
+ * 
+ * @param saida Pointer to the output.
+ * @param texto String to write.
+ */
+void escreve_texto(Saida *saida, const char *texto) {
+    escreve_bytes(saida, texto, (int)strlen(texto));
+}
+
+/**
+ * @brief Writes a string and a newline to an output.
+ * 
+ * @param saida Pointer to the output.
+ * @param texto String to write.
+ */
+void escreve_linha(Saida *saida, const char *texto) {
+    escreve_texto(saida, texto);
+    escreve_caracter(saida, '\n');
+}
+
+/**
+ * @brief Writes a character to an output.
+ * 
+ * @param saida Pointer to the output.
+ * @param c Character to write.
+ */
+void escreve_caracter(Saida *saida, char c) {
+    if (saida->tamanho < saida->capacidade) {
+        saida->buffer[saida->tamanho++] = c;
+    } else {
+        escreve_bytes(saida, &c, 1);
+    }
+}
+
+/**
+ * @brief Formats a non-negative integer, like the "%d" of printf.
+ * 
+ * @param texto Array where the digits are written, with room for 10 digits.
+ * @param valor Integer to format.
+ * 
+ * @return The number of digits written.
+ */
+static int formata_inteiro(char *texto, unsigned int valor) {
+    char digitos[10];
+    int n = 0;
+    do {
+        digitos[n++] = (char)('0' + valor % 10);
+        valor /= 10;
+    } while (valor > 0);
+    for (int i = 0; i < n; i++) {
+        texto[i] = digitos[n - 1 - i];
+    }
+    return n;
+}
+
+/**
+ * @brief Writes an integer to an output, like the "%d" of printf.
+ * 
+ * @param saida Pointer to the output.
+ * @param valor Integer to write.
+ */
+void escreve_inteiro(Saida *saida, int valor) {
+    char texto[11];
+    int n = 0;
+    unsigned int absoluto = (unsigned int)valor;
+    if (valor < 0) {
+        texto[n++] = '-';
+        absoluto = 0u - absoluto;
+    }
+    n += formata_inteiro(texto + n, absoluto);
+    escreve_bytes(saida, texto, n);
+}
+
+/**
+ * @brief Writes a long integer to an output, like the "%lld" of printf.
+ * 
+ * @param saida Pointer to the output.
+ * @param valor Integer to write.
+ */
+void escreve_longo(Saida *saida, long long valor) {
+    char texto[20];
+    int n = (int)sizeof(texto);
+    unsigned long long absoluto = (unsigned long long)valor;
+    if (valor < 0) absoluto = 0ull - absoluto;
+    do {
+        texto[--n] = (char)('0' + absoluto % 10);
+        absoluto /= 10;
+    } while (absoluto > 0);
+    if (valor < 0) texto[--n] = '-';
+    escreve_bytes(saida, texto + n, (int)sizeof(texto) - n);
+}
+
+/**
+ * @brief Writes a date to an output, like the "%02d-%02d-%d" of printf.
+ * 
+ * @param saida Pointer to the output.
+ * @param data Packed date.
+ * 
+ * @note Listings repeat a few dates many times, so the last
+ * dates formatted are kept by the output.
+ */
+void escreve_data(Saida *saida, Data data) {
+    DataFormatada *formatada =
+        &saida->datas[((unsigned int)data * 2654435761u) >> 16 & (TAM_CACHE_DATAS - 1)];
+    if (formatada->data != data) {
+        char *texto = formatada->texto;
+        texto[0] = (char)('0' + data_dia(data) / 10);
+        texto[1] = (char)('0' + data_dia(data) % 10);
+        texto[2] = '-';
+        texto[3] = (char)('0' + data_mes(data) / 10);
+        texto[4] = (char)('0' + data_mes(data) % 10);
+        texto[5] = '-';
+        formatada->tamanho = 6 + formata_inteiro(texto + 6, (unsigned int)data_ano(data));
+        formatada->data = data;
+    }
+    escreve_bytes(saida, formatada->texto, formatada->tamanho);
+}
@@ -0,0 +1,72 @@
+/**
+ * Declarations for the reading and parsing of the commands
+ * of the vaccination system.
+ * @file: io_func.h
+ * @author: ist1114613 (João Tamagnini)
+ */
+#ifndef IO_FUNC_H
+#define IO_FUNC_H
+#include "headers.h"
+
+/// @defgroup io_funcs Input and output functions.
+/// @{
+
+/// Initializes a reader of commands from a file.
+int inicia_leitor(Leitor *leitor, FILE *ficheiro, Saida *saida, Journal *journal);
+
+/// Reads the letter of the next command.
+int le_comando(Leitor *leitor);
+
+/// Reads the rest of the current line.
+char *le_linha(Leitor *leitor);
+
+/// Checks if the next command is in the buffer of a reader.
+int leitor_pronto(Leitor *leitor);
+
+/// Frees the memory allocated for a reader.
+void liberta_leitor(Leitor *leitor);
+
+/// Reads the next word of a line.
+char *proxima_palavra(char **cursor);
+
+/// Reads the next integer of a line.
+int proximo_inteiro(char **cursor, int *valor);
+
+/// Reads the next date of a line.
+int proxima_data(char **cursor, int *dia, int *mes, int *ano);
+
+/// Initializes an output to a file descriptor.
+int inicia_saida(Saida *saida, int fd, int capacidade);
+
+/// Writes the text kept by an output.
+void despeja_saida(Saida *saida);
+
+/// Writes a block of output to a file descriptor.
+void escreve_bloco(int fd, const Bloco *bloco);
+
+/// Frees the memory allocated for an output, writing its text first.
+void liberta_saida(Saida *saida);
+
+/// Writes bytes to an output.
+void escreve_bytes(Saida *saida, const char *bytes, int tamanho);
+
+/// Writes a string to an output.
+void escreve_texto(Saida *saida, const char *texto);
+
+/// Writes a string and a newline to an output.
+void escreve_linha(Saida *saida, const char *texto);
+
+/// Writes a character to an output.
+void escreve_caracter(Saida *saida, char c);
+
+/// Writes an integer to an output.
+void escreve_inteiro(Saida *saida, int valor);
+
+/// Writes a long integer to an output.
+void escreve_longo(Saida *saida, long long valor);
+
+/// Writes a date to an output, as dd-mm-yyyy.
+void escreve_data(Saida *saida, Data data);
+
+/// @}
+#endif
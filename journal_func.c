@@ -0,0 +1,361 @@
+/**
+ * Implementation of the journal of the vaccination system.
+ * 
+ * The journal is a binary file with a header followed by a record for
+ * each command that changed the system, with its letter and the rest
+ * of its line. Each record starts with its size and a checksum, so a
+ * record cut by a crash is detected and dropped when the journal is
+ * replayed. The records are kept in a buffer and synced to the disk in
+ * groups, every given number of records or milliseconds. While threads
+ * share the journal, it is locked to append or write its records.
+ * @file: journal_func.c
+ * @author: ist1114613 (João Tamagnini)
+ */
+#include "headers.h"
+#include <fcntl.h>
+#include <time.h>
+
+/**
+ * @brief Gets the current time in milliseconds.
+ * 
+ * @return The milliseconds since an arbitrary point.
+ */
+static long long agora_ms(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (long long)t.tv_sec * 1000 + t.tv_nsec / 1000000;
+}
+
+/**
+ * @brief Computes the checksum of the contents of a record.
+ * 
+ * @param dados Contents of the record.
+ * @param tamanho Number of bytes of the contents.
+ * 
+ * @return The checksum.
+ */
+static unsigned int soma_registo(const char *dados, int tamanho) {
+    unsigned int soma = 2166136261u;
+    for (int i = 0; i < tamanho; i++) {
+        soma ^= (unsigned char)dados[i];
+        soma *= 16777619u;
+    }
+    return soma;
+}
+
+/**
+ * @brief Replays the records of a journal file on top of the system,
+ * starting at a position, and drops a last record cut by a crash.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param ficheiro Name of the journal file.
+ * @param posicao Position of the first record to replay, 0 for the first
+ * record of the file.
+ * @param current_language Language for error messages.
+ * 
+ * @return 1 if successful or if the file does not exist, 0 otherwise.
+ * 
+ * @note The answers of the replayed commands are discarded.
+ */
+int recupera_journal(Sistema *sistema, const char *ficheiro, long long posicao,
+                     char *current_language) {
+    FILE *f = fopen(ficheiro, "rb");
+    if (f == NULL) return posicao == 0;
+
+    // An empty file was created by a crash before its header was written.
+    CabecalhoJournal cabecalho;
+    size_t lidos = fread(&cabecalho, 1, sizeof(cabecalho), f);
+    if (lidos == 0 && posicao == 0) {
+        fclose(f);
+        return 1;
+    }
+    if (posicao == 0) posicao = sizeof(cabecalho);
+    if (lidos != sizeof(cabecalho) || posicao < (long long)sizeof(cabecalho) ||
+        memcmp(cabecalho.magica, JOURNAL_MAGICA, sizeof(cabecalho.magica)) != 0 ||
+        cabecalho.versao != JOURNAL_VERSAO || fseeko(f, 0, SEEK_END) != 0 ||
+        ftello(f) < posicao || fseeko(f, posicao, SEEK_SET) != 0) {
+        fclose(f);
+        return 0;
+    }
+
+    // Replay the records until the end or until a record is incomplete.
+    Saida nula;
+    inicia_saida(&nula, -1, TAM_BLOCO_ESCRITA);
+    char *registo = NULL;
+    int capacidade = 0;
+    CabecalhoRegisto cabecalhoRegisto;
+    while (fread(&cabecalhoRegisto, sizeof(cabecalhoRegisto), 1, f) == 1 &&
+           cabecalhoRegisto.tamanho > 0 && cabecalhoRegisto.tamanho < (1 << 30)) {
+        if (cabecalhoRegisto.tamanho >= capacidade) {
+            char *novo = (char *)realloc(registo, cabecalhoRegisto.tamanho + 1);
+            if (novo == NULL) break;
+            registo = novo;
+            capacidade = cabecalhoRegisto.tamanho + 1;
+        }
+        if (fread(registo, 1, cabecalhoRegisto.tamanho, f) != (size_t)cabecalhoRegisto.tamanho ||
+            soma_registo(registo, cabecalhoRegisto.tamanho) != cabecalhoRegisto.soma) {
+            break;
+        }
+        registo[cabecalhoRegisto.tamanho] = '\0';
+        executa_comando(sistema, registo[0], registo + 1, &nula, current_language);
+        posicao += sizeof(cabecalhoRegisto) + cabecalhoRegisto.tamanho;
+    }
+    free(registo);
+    liberta_saida(&nula);
+    fclose(f);
+
+    // Drop what is after the last complete record, so new records follow it.
+    return truncate(ficheiro, posicao) == 0;
+}
+
+/**
+ * @brief Writes bytes to the file of the journal, retrying until all
+ * of them are written.
+ * 
+ * @param journal Pointer to the journal.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+static int escreve_journal(Journal *journal) {
+    const char *bytes = journal->buffer;
+    int tamanho = journal->tamanho;
+    journal->tamanho = 0;
+    while (tamanho > 0) {
+        ssize_t escritos = write(journal->fd, bytes, tamanho);
+        if (escritos <= 0) {
+            journal->falhou = 1;
+            return 0;
+        }
+        bytes += escritos;
+        tamanho -= (int)escritos;
+    }
+    return 1;
+}
+
+/**
+ * @brief Writes and syncs the records of the journal, with the journal
+ * already locked.
+ * 
+ * @param journal Pointer to the journal.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+static int sincroniza(Journal *journal) {
+    if (!escreve_journal(journal)) return 0;
+    if (journal->porSincronizar > 0) {
+        journal->porSincronizar = 0;
+        if (fsync(journal->fd) != 0) {
+            journal->falhou = 1;
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Writes the records of the journal, syncing them if the
+ * journal syncs by number or by time, with the journal already locked.
+ * 
+ * @param journal Pointer to the journal.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+static int despeja(Journal *journal) {
+    if (journal->sincronizarCada > 0 || journal->sincronizarMs > 0) {
+        return sincroniza(journal);
+    }
+    return escreve_journal(journal);
+}
+
+/**
+ * @brief Opens a journal file to append records to it, creating it
+ * if it does not exist.
+ * 
+ * @param journal Pointer to the journal.
+ * @param ficheiro Name of the journal file.
+ * @param sincronizarCada Number of records after which they are synced,
+ * 0 to not sync by number.
+ * @param sincronizarMs Milliseconds after which the records are synced,
+ * 0 to not sync by time.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+int abre_journal(Journal *journal, const char *ficheiro, int sincronizarCada,
+                 int sincronizarMs) {
+    memset(journal, 0, sizeof(Journal));
+    journal->sincronizarCada = sincronizarCada;
+    journal->sincronizarMs = sincronizarMs;
+    journal->fd = open(ficheiro, O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (journal->fd < 0) return 0;
+    journal->capacidade = TAM_BLOCO_JOURNAL;
+    journal->buffer = (char *)malloc(journal->capacidade);
+    journal->posicao = lseek(journal->fd, 0, SEEK_END);
+    if (journal->buffer == NULL || journal->posicao < 0) {
+        fecha_journal(journal);
+        return 0;
+    }
+
+    // A new journal starts with its header.
+    if (journal->posicao == 0) {
+        CabecalhoJournal cabecalho;
+        memset(&cabecalho, 0, sizeof(cabecalho));
+        memcpy(cabecalho.magica, JOURNAL_MAGICA, sizeof(JOURNAL_MAGICA));
+        cabecalho.versao = JOURNAL_VERSAO;
+        memcpy(journal->buffer, &cabecalho, sizeof(cabecalho));
+        journal->tamanho = sizeof(cabecalho);
+        journal->posicao = sizeof(cabecalho);
+        journal->porSincronizar = 1;
+        if (!sincroniza(journal)) {
+            fecha_journal(journal);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Prepares the record of a command, before it runs and splits
+ * its line. The record is kept on the stack when it is small, and is
+ * only appended to the journal if the command changes the system.
+ * 
+ * @param registo Pointer to the record.
+ * @param journal Pointer to the journal, or NULL if there is none.
+ * @param comando Letter of the command.
+ * @param linha Rest of the line of the command.
+ * 
+ * @note If there is no memory for the record, appending it fails.
+ */
+void prepara_registo_journal(RegistoJournal *registo, Journal *journal, int comando,
+                             const char *linha) {
+    registo->journal = journal;
+    registo->dados = NULL;
+    if (journal == NULL) return;
+    CabecalhoRegisto cabecalho;
+    cabecalho.tamanho = (int)strlen(linha) + 1;
+    registo->tamanho = (int)sizeof(cabecalho) + cabecalho.tamanho;
+    registo->dados = registo->tamanho <= TAM_REGISTO_LOCAL ? registo->local :
+                     (char *)malloc(registo->tamanho);
+    if (registo->dados == NULL) return;
+    char *conteudo = registo->dados + sizeof(cabecalho);
+    conteudo[0] = (char)comando;
+    memcpy(conteudo + 1, linha, cabecalho.tamanho - 1);
+    cabecalho.soma = soma_registo(conteudo, cabecalho.tamanho);
+    memcpy(registo->dados, &cabecalho, sizeof(cabecalho));
+}
+
+/**
+ * @brief Frees the memory of a record, if it was not kept on the stack.
+ * 
+ * @param registo Pointer to the record.
+ */
+void liberta_registo_journal(RegistoJournal *registo) {
+    if (registo->dados != registo->local) free(registo->dados);
+    registo->dados = NULL;
+}
+
+/**
+ * @brief Appends a prepared record to its journal, and writes and
+ * syncs the records when the journal syncs them.
+ * 
+ * @param registo Pointer to the record.
+ * 
+ * @return 1 if successful or if there is no journal, 0 otherwise.
+ */
+int acrescenta_registo_journal(RegistoJournal *registo) {
+    Journal *journal = registo->journal;
+    if (journal == NULL) return 1;
+    bloqueia(&journal->bloqueio, journal->concorrente);
+    int ok = registo->dados != NULL;
+    int necessario = journal->tamanho + registo->tamanho;
+    if (ok && necessario > journal->capacidade) {
+        int capacidade = journal->capacidade;
+        while (capacidade < necessario) capacidade *= 2;
+        char *buffer = (char *)realloc(journal->buffer, capacidade);
+        ok = buffer != NULL;
+        if (ok) {
+            journal->buffer = buffer;
+            journal->capacidade = capacidade;
+        }
+    }
+    if (!ok) {
+        journal->falhou = 1;
+        desbloqueia(&journal->bloqueio, journal->concorrente);
+        return 0;
+    }
+    memcpy(journal->buffer + journal->tamanho, registo->dados, registo->tamanho);
+    journal->tamanho += registo->tamanho;
+    journal->posicao += registo->tamanho;
+
+    // Sync the group of records when it is big or old enough.
+    if (journal->porSincronizar++ == 0 && journal->sincronizarMs > 0) {
+        journal->inicioPorSincronizar = agora_ms();
+    }
+    if ((journal->sincronizarCada > 0 && journal->porSincronizar >= journal->sincronizarCada) ||
+        (journal->sincronizarMs > 0 &&
+         agora_ms() - journal->inicioPorSincronizar >= journal->sincronizarMs)) {
+        ok = sincroniza(journal);
+    } else if (journal->tamanho >= TAM_BLOCO_JOURNAL) {
+        ok = escreve_journal(journal);
+    }
+    desbloqueia(&journal->bloqueio, journal->concorrente);
+    return ok;
+}
+
+/**
+ * @brief Checks if writing the journal failed since it was last checked.
+ * 
+ * @param journal Pointer to the journal.
+ * 
+ * @return 1 if it failed, 0 otherwise.
+ */
+int falhou_journal(Journal *journal) {
+    bloqueia(&journal->bloqueio, journal->concorrente);
+    int falhou = journal->falhou;
+    journal->falhou = 0;
+    desbloqueia(&journal->bloqueio, journal->concorrente);
+    return falhou;
+}
+
+/**
+ * @brief Writes the records of the journal, syncing them if the
+ * journal syncs by number or by time.
+ * 
+ * @param journal Pointer to the journal.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+int despeja_journal(Journal *journal) {
+    bloqueia(&journal->bloqueio, journal->concorrente);
+    int ok = despeja(journal);
+    desbloqueia(&journal->bloqueio, journal->concorrente);
+    return ok;
+}
+
+/**
+ * @brief Writes and syncs the records of the journal.
+ * 
+ * @param journal Pointer to the journal.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+int sincroniza_journal(Journal *journal) {
+    bloqueia(&journal->bloqueio, journal->concorrente);
+    int ok = sincroniza(journal);
+    desbloqueia(&journal->bloqueio, journal->concorrente);
+    return ok;
+}
+
+/**
+ * @brief Writes the records of the journal and closes it.
+ * 
+ * @param journal Pointer to the journal.
+ */
+void fecha_journal(Journal *journal) {
+    if (journal->fd >= 0) {
+        if (journal->buffer != NULL) despeja(journal);
+        close(journal->fd);
+        journal->fd = -1;
+    }
+    free(journal->buffer);
+    journal->buffer = NULL;
+}
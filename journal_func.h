@@ -0,0 +1,44 @@
+/**
+ * Declarations for the journal of the vaccination system.
+ * @file: journal_func.h
+ * @author: ist1114613 (João Tamagnini)
+ */
+#ifndef JOURNAL_FUNC_H
+#define JOURNAL_FUNC_H
+#include "headers.h"
+
+/// @defgroup journal_funcs Journal functions.
+/// @{
+
+/// Replays the records of a journal file on top of the system.
+int recupera_journal(Sistema *sistema, const char *ficheiro, long long posicao,
+                     char *current_language);
+
+/// Opens a journal file to append records to it.
+int abre_journal(Journal *journal, const char *ficheiro, int sincronizarCada,
+                 int sincronizarMs);
+
+/// Prepares the record of a command, before it runs.
+void prepara_registo_journal(RegistoJournal *registo, Journal *journal, int comando,
+                             const char *linha);
+
+/// Appends a prepared record to its journal.
+int acrescenta_registo_journal(RegistoJournal *registo);
+
+/// Frees the memory of a record.
+void liberta_registo_journal(RegistoJournal *registo);
+
+/// Checks if writing the journal failed since it was last checked.
+int falhou_journal(Journal *journal);
+
+/// Writes the records of the journal, syncing them if the journal syncs.
+int despeja_journal(Journal *journal);
+
+/// Writes and syncs the records of the journal.
+int sincroniza_journal(Journal *journal);
+
+/// Writes the records of the journal and closes it.
+void fecha_journal(Journal *journal);
+
+/// @}
+#endif
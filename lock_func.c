@@ -0,0 +1,97 @@
+/**
+ * Implementation of the locks that let the threads of the server
+ * share the vaccination system.
+ * 
+ * The vaccinations take the lock of the system in shared mode, so that
+ * they run at the same time, and every other command takes it alone.
+ * Between them, the vaccinations only lock the shard of their vaccine,
+ * the shard of their user and, for a moment, the inoculations, the
+ * versions and the journal, always in this order. The listings take
+ * the lock of the system in shared mode only to take their version.
+ * The locks are only used while the system is shared, so a single
+ * thread never pays for them.
+ * @file: lock_func.c
+ * @author: ist1114613 (João Tamagnini)
+ */
+#define _GNU_SOURCE
+#include "headers.h"
+
+/**
+ * @brief Creates the locks of the system and of the journal, so that
+ * several threads share them. The lock of the system prefers the
+ * commands that take it alone, so a stream of vaccinations does not
+ * hold them back forever.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param journal Pointer to the journal, or NULL if there is none.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+int inicia_bloqueios(Sistema *sistema, Journal *journal) {
+    pthread_rwlockattr_t atributos;
+    if (pthread_rwlockattr_init(&atributos) != 0) return 0;
+    pthread_rwlockattr_setkind_np(&atributos, PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+    int ok = pthread_rwlock_init(&sistema->bloqueio, &atributos) == 0;
+    pthread_rwlockattr_destroy(&atributos);
+    if (!ok) return 0;
+    pthread_mutex_init(&sistema->bloqueioInoculacoes, NULL);
+    pthread_mutex_init(&sistema->versoes.bloqueio, NULL);
+    for (int i = 0; i < NUM_FATIAS; i++) {
+        pthread_mutex_init(&sistema->fatiasVacinas[i].bloqueio, NULL);
+        pthread_mutex_init(&sistema->fatiasUtentes[i].bloqueio, NULL);
+    }
+    sistema->concorrente = 1;
+    if (journal != NULL) {
+        pthread_mutex_init(&journal->bloqueio, NULL);
+        journal->concorrente = 1;
+    }
+    return 1;
+}
+
+/**
+ * @brief Locks the system for a command.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param exclusivo 1 for a command that runs alone, 0 for a
+ * vaccination, which runs together with other vaccinations.
+ */
+void bloqueia_sistema(Sistema *sistema, int exclusivo) {
+    if (!sistema->concorrente) return;
+    if (exclusivo) {
+        pthread_rwlock_wrlock(&sistema->bloqueio);
+    } else {
+        pthread_rwlock_rdlock(&sistema->bloqueio);
+    }
+}
+
+/**
+ * @brief Unlocks the system after a command.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ */
+void desbloqueia_sistema(Sistema *sistema) {
+    if (sistema->concorrente) pthread_rwlock_unlock(&sistema->bloqueio);
+}
+
+/**
+ * @brief Destroys the locks of the system and of the journal, once
+ * a single thread uses them again.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param journal Pointer to the journal, or NULL if there is none.
+ */
+void liberta_bloqueios(Sistema *sistema, Journal *journal) {
+    if (!sistema->concorrente) return;
+    pthread_rwlock_destroy(&sistema->bloqueio);
+    pthread_mutex_destroy(&sistema->bloqueioInoculacoes);
+    pthread_mutex_destroy(&sistema->versoes.bloqueio);
+    for (int i = 0; i < NUM_FATIAS; i++) {
+        pthread_mutex_destroy(&sistema->fatiasVacinas[i].bloqueio);
+        pthread_mutex_destroy(&sistema->fatiasUtentes[i].bloqueio);
+    }
+    sistema->concorrente = 0;
+    if (journal != NULL && journal->concorrente) {
+        pthread_mutex_destroy(&journal->bloqueio);
+        journal->concorrente = 0;
+    }
+}
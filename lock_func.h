@@ -0,0 +1,47 @@
+/**
+ * Declarations for the locks that let the threads of the server
+ * share the vaccination system.
+ * @file: lock_func.h
+ * @author: ist1114613 (João Tamagnini)
+ */
+#ifndef LOCK_FUNC_H
+#define LOCK_FUNC_H
+#include "headers.h"
+
+/// @defgroup lock_funcs Lock functions.
+/// @{
+
+/**
+ * @brief Locks a mutex, if the system is shared by several threads.
+ * 
+ * @param bloqueio Pointer to the mutex.
+ * @param concorrente 1 if the system is shared by several threads.
+ */
+static inline void bloqueia(pthread_mutex_t *bloqueio, int concorrente) {
+    if (concorrente) pthread_mutex_lock(bloqueio);
+}
+
+/**
+ * @brief Unlocks a mutex, if the system is shared by several threads.
+ * 
+ * @param bloqueio Pointer to the mutex.
+ * @param concorrente 1 if the system is shared by several threads.
+ */
+static inline void desbloqueia(pthread_mutex_t *bloqueio, int concorrente) {
+    if (concorrente) pthread_mutex_unlock(bloqueio);
+}
+
+/// Creates the locks of the system and of the journal, so that several threads share them.
+int inicia_bloqueios(Sistema *sistema, Journal *journal);
+
+/// Locks the system for a command, alone or together with other vaccinations.
+void bloqueia_sistema(Sistema *sistema, int exclusivo);
+
+/// Unlocks the system after a command.
+void desbloqueia_sistema(Sistema *sistema);
+
+/// Destroys the locks of the system and of the journal.
+void liberta_bloqueios(Sistema *sistema, Journal *journal);
+
+/// @}
+#endif
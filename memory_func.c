@@ -0,0 +1,178 @@
+/**
+ * Implementation of the report of the memory taken by the data
+ * structures of the vaccination system.
+ * 
+ * For each structure the report gives the bytes reserved, the bytes
+ * used by its records, the slack left by the growth of its arrays and
+ * the overhead of malloc, estimated from the way glibc rounds its
+ * blocks, which dominates for the many small blocks of the users.
+ * @file: memory_func.c
+ * @author: ist1114613 (João Tamagnini)
+ */
+#include "headers.h"
+
+/**
+ * @brief Estimates the bytes malloc takes for a block: a header and
+ * the rounding to its alignment, or whole pages for large blocks.
+ * 
+ * @param bytes Size of the block asked for.
+ * 
+ * @return The estimated size of the block.
+ */
+static long long custo_alocacao(long long bytes) {
+    long long custo = bytes + (long long)sizeof(size_t);
+    if (custo >= LIMIAR_MMAP) {
+        return (custo + sizeof(size_t) + TAM_PAGINA - 1) / TAM_PAGINA * TAM_PAGINA;
+    }
+    custo = (custo + ALINHAMENTO_MALLOC - 1) / ALINHAMENTO_MALLOC * ALINHAMENTO_MALLOC;
+    return custo > MINIMO_MALLOC ? custo : MINIMO_MALLOC;
+}
+
+/**
+ * @brief Counts a block of memory reserved for a data structure.
+ * 
+ * @param contagem Pointer to the memory of the structure.
+ * @param bytes Size of the block asked for, 0 if it was not allocated.
+ */
+static void reserva(ContagemMemoria *contagem, long long bytes) {
+    if (bytes <= 0) return;
+    long long custo = custo_alocacao(bytes);
+    contagem->reservados += custo;
+    contagem->sobrecarga += custo - bytes;
+}
+
+/**
+ * @brief Counts the memory reserved and used by a name index.
+ * 
+ * @param contagem Pointer to the memory of the index.
+ * @param indice Pointer to the name index.
+ */
+static void conta_indice(ContagemMemoria *contagem, const IndiceNomes *indice) {
+    long long porPosicao = sizeof(const char *) + sizeof(int);
+    reserva(contagem, (long long)indice->capacidade * sizeof(const char *));
+    reserva(contagem, (long long)indice->capacidade * sizeof(int));
+    contagem->usados += indice->tamanho * porPosicao;
+}
+
+/**
+ * @brief Counts the memory reserved and used by an arena of names. The
+ * blocks of names are large, so what malloc adds to them is left out.
+ * 
+ * @param contagem Pointer to the memory of the names.
+ * @param arena Pointer to the arena of names.
+ */
+static void conta_nomes(ContagemMemoria *contagem, const ArenaNomes *arena) {
+    reserva(contagem, (long long)arena->capacidadeBlocos * sizeof(char *));
+    contagem->reservados += arena->reservados;
+    contagem->usados += arena->usados + (long long)arena->numBlocos * sizeof(char *);
+}
+
+/**
+ * @brief Prints the memory taken by a data structure, as
+ * "<name> <reserved> <used> <slack> <overhead>", and adds it to the total.
+ * 
+ * @param saida Output where the line is written.
+ * @param nome Name of the structure.
+ * @param contagem Pointer to the memory of the structure.
+ * @param total Pointer to the memory of all the structures, or NULL.
+ */
+static void escreve_contagem(Saida *saida, const char *nome, const ContagemMemoria *contagem,
+                             ContagemMemoria *total) {
+    escreve_texto(saida, nome);
+    escreve_caracter(saida, ' ');
+    escreve_longo(saida, contagem->reservados);
+    escreve_caracter(saida, ' ');
+    escreve_longo(saida, contagem->usados);
+    escreve_caracter(saida, ' ');
+    escreve_longo(saida, contagem->reservados - contagem->usados - contagem->sobrecarga);
+    escreve_caracter(saida, ' ');
+    escreve_longo(saida, contagem->sobrecarga);
+    escreve_caracter(saida, '\n');
+    if (total != NULL) {
+        total->reservados += contagem->reservados;
+        total->usados += contagem->usados;
+        total->sobrecarga += contagem->sobrecarga;
+    }
+}
+
+/**
+ * @brief Prints the memory taken by each data structure of the system
+ * and by all of them. The free positions of deleted inoculations and
+ * removed batches, and the ends of the blocks of names that a name did
+ * not fit in, are counted as slack.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param saida Output where the report is written.
+ */
+void escreve_memoria(Sistema *sistema, Saida *saida) {
+    ContagemMemoria total = { 0, 0, 0 };
+
+    ContagemMemoria inoculacoes = { 0, 0, 0 };
+    for (int i = 0; i < sistema->numSegmentosInoculacoes; i++) {
+        reserva(&inoculacoes, INOCULACOES_POR_SEGMENTO * sizeof(Inoculacao));
+    }
+    reserva(&inoculacoes,
+            (long long)sistema->capacidadeSegmentosInoculacoes * sizeof(Inoculacao *));
+    inoculacoes.usados =
+        (long long)sistema->numInoculacoes * sizeof(Inoculacao) +
+        (long long)sistema->numSegmentosInoculacoes * sizeof(Inoculacao *);
+    escreve_contagem(saida, "inoculations", &inoculacoes, &total);
+
+    ContagemMemoria lotes = { 0, 0, 0 };
+    for (int i = 0; i < sistema->numBlocosLotes; i++) {
+        reserva(&lotes, LOTES_POR_BLOCO * sizeof(Lote));
+    }
+    reserva(&lotes, (long long)sistema->capacidadeBlocosLotes * sizeof(Lote *));
+    reserva(&lotes, (long long)sistema->capacidadeLotes * sizeof(int));
+    reserva(&lotes, (long long)sistema->capacidadeLotes * sizeof(int));
+    lotes.usados = (long long)sistema->numLotes * (sizeof(Lote) + sizeof(int)) +
+                   (long long)sistema->numBlocosLotes * sizeof(Lote *) +
+                   (long long)sistema->numLotesLivres * sizeof(int);
+    escreve_contagem(saida, "batches", &lotes, &total);
+
+    ContagemMemoria vacinas = { 0, 0, 0 };
+    reserva(&vacinas, (long long)sistema->capacidadeVacinas * sizeof(Vacina));
+    vacinas.usados = (long long)sistema->numVacinas * sizeof(Vacina);
+    for (int i = 0; i < sistema->numVacinas; i++) {
+        Vacina *vacina = &sistema->vacinas[i];
+        reserva(&vacinas, (long long)vacina->capacidadeHeap * sizeof(int));
+        vacinas.usados += (long long)vacina->tamanhoHeap * sizeof(int);
+    }
+    escreve_contagem(saida, "vaccines", &vacinas, &total);
+
+    // The users, their indexes, their vaccinations and their names are summed over the shards.
+    ContagemMemoria utentes = { 0, 0, 0 };
+    ContagemMemoria listas = { 0, 0, 0 };
+    ContagemMemoria indiceUtentes = { 0, 0, 0 };
+    ContagemMemoria vacinacoes = { 0, 0, 0 };
+    ContagemMemoria nomes = { 0, 0, 0 };
+    conta_nomes(&nomes, &sistema->nomes);
+    for (int f = 0; f < NUM_FATIAS; f++) {
+        const FatiaUtentes *fatia = &sistema->fatiasUtentes[f];
+        reserva(&utentes, (long long)fatia->capacidadeUtentes * sizeof(Utente));
+        utentes.usados += (long long)fatia->numUtentes * sizeof(Utente);
+        for (int i = 0; i < fatia->numUtentes; i++) {
+            const Utente *utente = &fatia->utentes[i];
+            reserva(&listas, (long long)utente->capacidadeInoculacoes * sizeof(int));
+            listas.usados += (long long)utente->numInoculacoes * sizeof(int);
+        }
+        conta_indice(&indiceUtentes, &fatia->indice);
+        reserva(&vacinacoes, (long long)fatia->vacinacoes.capacidade * sizeof(ChaveVacinacao));
+        vacinacoes.usados += (long long)fatia->vacinacoes.tamanho * sizeof(ChaveVacinacao);
+        conta_nomes(&nomes, &fatia->nomes);
+    }
+    escreve_contagem(saida, "users", &utentes, &total);
+    escreve_contagem(saida, "user-inoculations", &listas, &total);
+    escreve_contagem(saida, "names", &nomes, &total);
+
+    ContagemMemoria indice = { 0, 0, 0 };
+    conta_indice(&indice, &sistema->indiceLotes);
+    escreve_contagem(saida, "batch-index", &indice, &total);
+    indice = (ContagemMemoria){ 0, 0, 0 };
+    conta_indice(&indice, &sistema->indiceVacinas);
+    escreve_contagem(saida, "vaccine-index", &indice, &total);
+    escreve_contagem(saida, "user-index", &indiceUtentes, &total);
+    escreve_contagem(saida, "vaccinations", &vacinacoes, &total);
+
+    escreve_contagem(saida, "total", &total, NULL);
+}
@@ -0,0 +1,17 @@
+/**
+ * Declaration of the functions that report the memory taken by the
+ * data structures of the vaccination system.
+ * @file: memory_func.h
+ * @author: ist1114613 (João Tamagnini)
+ */
+#ifndef MEMORY_FUNC_H
+#define MEMORY_FUNC_H
+
+/// @defgroup memory_funcs Memory report functions.
+/// @{
+
+/// Prints the memory taken by each data structure of the system.
+void escreve_memoria(Sistema *sistema, Saida *saida);
+
+/// @}
+#endif
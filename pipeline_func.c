@@ -0,0 +1,262 @@
+/**
+ * Implementation of the pipeline of the vaccination system, which runs
+ * the commands of a reader in three stages, each in its own thread.
+ * 
+ * The parser reads the commands and copies each one, as its letter and
+ * its line, into blocks of commands. The executor, which is the thread
+ * that starts the pipeline, runs the commands of each block in order
+ * and keeps their answers in blocks of output, which the writer writes.
+ * So reading the input and writing the output overlap with running the
+ * commands, which are still run one at a time and in the order of the
+ * input, so the output is the same as without the pipeline.
+ * 
+ * The parser only splits the input in lines and does not parse their
+ * parameters. Each command parses its line while it checks it, in the
+ * order that decides which error it prints, and the journal keeps the
+ * line as it was read, so parsing it in the parser would not take work
+ * from the executor. What the pipeline saves is the reading and the
+ * writing, and it reads ahead up to its blocks of commands, much more
+ * than a pipe holds, so a source that sends the commands in bursts is
+ * not kept waiting while they run.
+ * 
+ * The blocks go between two stages in lock-free rings with a single
+ * producer and a single consumer, and come back empty in another ring.
+ * Only as many blocks go round as half a ring holds, so a ring never
+ * fills and only its consumer waits, spinning for a while and then
+ * sleeping on a futex until the producer passes it a block. The parser
+ * passes its block whenever the next command is not in the reader yet,
+ * and the executor writes the journal and then passes its output before
+ * waiting for commands, like the loop without the pipeline does before
+ * reading more input.
+ * @file: pipeline_func.c
+ * @author: ist1114613 (João Tamagnini)
+ */
+#include "headers.h"
+#include <linux/futex.h>
+#include <sys/syscall.h>
+
+/**
+ * @brief Passes a block to the consumer of a ring, waking it if it sleeps.
+ * 
+ * @param anel Pointer to the ring, of which this is the only producer.
+ * @param bloco Pointer to the block, or NULL to end the stage.
+ */
+void poe_bloco(Anel *anel, Bloco *bloco) {
+    unsigned int escrita = anel->escrita;
+    anel->blocos[escrita & (2 * NUM_BLOCOS_PIPELINE - 1)] = bloco;
+    __atomic_store_n(&anel->escrita, escrita + 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&anel->esperando, __ATOMIC_SEQ_CST)) {
+        syscall(SYS_futex, &anel->escrita, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+    }
+}
+
+/**
+ * @brief Takes the next block of a ring, waiting for it while the ring
+ * is empty.
+ * 
+ * @param anel Pointer to the ring, of which this is the only consumer.
+ * 
+ * @return The block, or NULL if the stage that produces it ended.
+ * 
+ * @note The consumer tells that it sleeps before checking the ring a
+ * last time, and the producer checks it after passing the block, so
+ * either the consumer sees the block or the producer wakes it.
+ */
+Bloco *tira_bloco(Anel *anel) {
+    unsigned int leitura = anel->leitura;
+    for (int i = 0; __atomic_load_n(&anel->escrita, __ATOMIC_ACQUIRE) == leitura; i++) {
+        if (i < ESPERA_ATIVA) continue;
+        __atomic_store_n(&anel->esperando, 1, __ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&anel->escrita, __ATOMIC_SEQ_CST) == leitura) {
+            syscall(SYS_futex, &anel->escrita, FUTEX_WAIT_PRIVATE, leitura, NULL, NULL, 0);
+        }
+        __atomic_store_n(&anel->esperando, 0, __ATOMIC_RELAXED);
+    }
+    Bloco *bloco = anel->blocos[leitura & (2 * NUM_BLOCOS_PIPELINE - 1)];
+    anel->leitura = leitura + 1;
+    return bloco;
+}
+
+/**
+ * @brief Checks if a ring is empty, without waiting.
+ * 
+ * @param anel Pointer to the ring, of which this is the only consumer.
+ * 
+ * @return 1 if taking a block would wait, 0 otherwise.
+ */
+static int anel_vazio(Anel *anel) {
+    return __atomic_load_n(&anel->escrita, __ATOMIC_ACQUIRE) == anel->leitura;
+}
+
+/**
+ * @brief Thread of the parser, which copies the commands of the reader
+ * into blocks, each as its letter and its line, until "q" or the end of
+ * the input.
+ * 
+ * @param argumento Pointer to the pipeline.
+ * 
+ * @return NULL.
+ * 
+ * @note A line larger than a block grows it, and if there is no memory
+ * for that the input ends there.
+ */
+static void *analisa_comandos(void *argumento) {
+    Pipeline *pipeline = (Pipeline *)argumento;
+    Leitor *leitor = pipeline->leitor;
+    Bloco *bloco = tira_bloco(&pipeline->comandos.vazios);
+    bloco->tamanho = 0;
+    int comando;
+    while ((comando = le_comando(leitor)) != EOF && comando != 'q') {
+        char *linha = le_linha(leitor);
+        int tamanho = (int)strlen(linha) + 2;
+        if (bloco->tamanho + tamanho > bloco->capacidade) {
+            if (bloco->tamanho > 0) {
+                poe_bloco(&pipeline->comandos.cheios, bloco);
+                bloco = tira_bloco(&pipeline->comandos.vazios);
+                bloco->tamanho = 0;
+            }
+            if (tamanho > bloco->capacidade) {
+                char *dados = (char *)realloc(bloco->dados, tamanho);
+                if (dados == NULL) break;
+                bloco->dados = dados;
+                bloco->capacidade = tamanho;
+            }
+        }
+        bloco->dados[bloco->tamanho] = (char)comando;
+        memcpy(bloco->dados + bloco->tamanho + 1, linha, tamanho - 1);
+        bloco->tamanho += tamanho;
+        // The commands read so far are run while waiting for more input.
+        if (!leitor_pronto(leitor)) {
+            poe_bloco(&pipeline->comandos.cheios, bloco);
+            bloco = tira_bloco(&pipeline->comandos.vazios);
+            bloco->tamanho = 0;
+        }
+    }
+    poe_bloco(&pipeline->comandos.cheios, bloco);
+    poe_bloco(&pipeline->comandos.cheios, NULL);
+    return NULL;
+}
+
+/**
+ * @brief Thread of the writer, which writes the blocks of output in
+ * order until the executor ends.
+ * 
+ * @param argumento Pointer to the pipeline.
+ * 
+ * @return NULL.
+ */
+static void *escreve_saidas(void *argumento) {
+    Pipeline *pipeline = (Pipeline *)argumento;
+    Bloco *bloco;
+    while ((bloco = tira_bloco(&pipeline->saidas.cheios)) != NULL) {
+        escreve_bloco(pipeline->fd, bloco);
+        poe_bloco(&pipeline->saidas.vazios, bloco);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Takes the next block of commands, writing the journal and then
+ * passing the output to the writer before waiting for it.
+ * 
+ * @param pipeline Pointer to the pipeline.
+ * @param journal Pointer to the journal, or NULL.
+ * @param saida Pointer to the output of the executor.
+ * 
+ * @return The block, or NULL at the end of the commands.
+ */
+static Bloco *espera_comandos(Pipeline *pipeline, Journal *journal, Saida *saida) {
+    if (anel_vazio(&pipeline->comandos.cheios)) {
+        if (journal != NULL) despeja_journal(journal);
+        despeja_saida(saida);
+    }
+    return tira_bloco(&pipeline->comandos.cheios);
+}
+
+/**
+ * @brief Runs the commands of a reader in a pipeline, with a thread
+ * that reads them and another that writes their answers, recording the
+ * time each command takes to run.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param journal Pointer to the journal, or NULL.
+ * @param estatisticas Pointer to the statistics of the commands.
+ * @param leitor Pointer to the reader of the commands.
+ * @param saida Pointer to the output of the answers.
+ * @param current_language Current language setting.
+ * 
+ * @return 1 after running the commands, 0 if the pipeline cannot start,
+ * in which case no command was read.
+ */
+int executa_pipeline(Sistema *sistema, Journal *journal, Estatisticas *estatisticas,
+                     Leitor *leitor, Saida *saida, char *current_language) {
+    Pipeline pipeline;
+    memset(&pipeline, 0, sizeof(pipeline));
+    pipeline.leitor = leitor;
+    pipeline.fd = saida->fd;
+    int numBlocos = 0;
+    for (; numBlocos < 2 * NUM_BLOCOS_PIPELINE; numBlocos++) {
+        Bloco *bloco = &pipeline.blocos[numBlocos];
+        bloco->dados = (char *)malloc(TAM_BLOCO_PIPELINE);
+        if (bloco->dados == NULL) break;
+        bloco->capacidade = TAM_BLOCO_PIPELINE;
+        poe_bloco(numBlocos < NUM_BLOCOS_PIPELINE ? &pipeline.comandos.vazios
+                                                  : &pipeline.saidas.vazios, bloco);
+    }
+
+    // The parser reads alone, so the reader does not write before reading.
+    Saida *saidaLeitor = leitor->saida;
+    Journal *journalLeitor = leitor->journal;
+    leitor->saida = NULL;
+    leitor->journal = NULL;
+    int escritor = 0, analisador = 0;
+    if (numBlocos == 2 * NUM_BLOCOS_PIPELINE) {
+        despeja_saida(saida);
+        escritor = pthread_create(&pipeline.escritor, NULL, escreve_saidas, &pipeline) == 0;
+        analisador = escritor &&
+            pthread_create(&pipeline.analisador, NULL, analisa_comandos, &pipeline) == 0;
+    }
+    if (analisador) {
+        char *buffer = saida->buffer;
+        int capacidade = saida->capacidade;
+        saida->canal = &pipeline.saidas;
+        saida->bloco = tira_bloco(&pipeline.saidas.vazios);
+        saida->buffer = saida->bloco->dados;
+        saida->capacidade = saida->bloco->capacidade;
+
+        Bloco *bloco;
+        while ((bloco = espera_comandos(&pipeline, journal, saida)) != NULL) {
+            long long inicio = relogio_ns();
+            for (int i = 0; i < bloco->tamanho;) {
+                int comando = (unsigned char)bloco->dados[i];
+                char *linha = bloco->dados + i + 1;
+                i += (int)strlen(linha) + 2;
+                processa_comando(sistema, journal, estatisticas, comando, linha, saida,
+                                 current_language);
+                long long fim = relogio_ns();
+                regista_latencia(estatisticas, 0, comando, fim - inicio);
+                inicio = fim;
+            }
+            poe_bloco(&pipeline.comandos.vazios, bloco);
+        }
+        if (journal != NULL) despeja_journal(journal);
+        despeja_saida(saida);
+        saida->bloco->dados = saida->buffer;
+        saida->bloco->capacidade = saida->capacidade;
+        saida->canal = NULL;
+        saida->bloco = NULL;
+        saida->buffer = buffer;
+        saida->capacidade = capacidade;
+        pthread_join(pipeline.analisador, NULL);
+    }
+    if (escritor) {
+        poe_bloco(&pipeline.saidas.cheios, NULL);
+        pthread_join(pipeline.escritor, NULL);
+    }
+    leitor->saida = saidaLeitor;
+    leitor->journal = journalLeitor;
+    for (int i = 0; i < numBlocos; i++) {
+        free(pipeline.blocos[i].dados);
+    }
+    return analisador;
+}
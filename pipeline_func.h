@@ -0,0 +1,25 @@
+/**
+ * Declarations for the pipeline of the vaccination system, which reads,
+ * runs and writes the commands of a reader in three threads.
+ * @file: pipeline_func.h
+ * @author: ist1114613 (João Tamagnini)
+ */
+#ifndef PIPELINE_FUNC_H
+#define PIPELINE_FUNC_H
+#include "headers.h"
+
+/// @defgroup pipeline_funcs Pipeline functions.
+/// @{
+
+/// Passes a block, or NULL at the end, to the consumer of a ring.
+void poe_bloco(Anel *anel, Bloco *bloco);
+
+/// Takes the next block of a ring, waiting for it while the ring is empty.
+Bloco *tira_bloco(Anel *anel);
+
+/// Runs the commands of a reader in a pipeline, writing their answers to an output.
+int executa_pipeline(Sistema *sistema, Journal *journal, Estatisticas *estatisticas,
+                     Leitor *leitor, Saida *saida, char *current_language);
+
+/// @}
+#endif
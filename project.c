@@ -1,65 +1,164 @@
-/* iaed25 - ist1114613 - project */
-/**
- * A program exemplifying a vaccine management system in C
- * Each vaccine has a batch number, name, date, and quantity
- * @file: project.c
- * @author: ist1114613 (João Tamagnini)
- */
-#include "headers.h"
-/**
- * @brief Main function of the vaccination management program.
- * 
- * This function initializes the system, sets the language based on 
- * command-line arguments, and enters a command-processing loop.
- * 
- * @param argc Number of command-line arguments.
- * @param argv Array of command-line argument strings.
- * 
- * @return int Returns 0 on program termination.
- */
-int main(int argc,const char *argv[]) {
-    char *current_language = "en";
-
-    /**
-     * @brief Set language to Portuguese if specified via command-line.
-     */
-    if (argc > 1 && strcmp(argv[1], "pt") == 0) {
-        current_language = "pt";
-    }
-
-    /**
-     * @brief Initialize the vaccination system structure.
-     */
-    Sistema sistema;
-    sistema.numLotes = 0;
-    sistema.numInoculacoes = 0;
-    sistema.capacidadeInoculacoes = MAX_LOTES;
-    sistema.dia_atual = 1;
-    sistema.mes_atual = 1;
-    sistema.ano_atual = 2025;
-    sistema.inoculacoes = (Inoculacao *)malloc(MAX_LOTES * sizeof(Inoculacao));
-
-    /**
-     * @brief Command processing loop. Reads commands from stdin and dispatches them.
-     */
-    char comando;
-    while (scanf(" %c", &comando) != EOF) {
-        switch(comando) {
-            case 'q':cleanupSistema(&sistema);return 0;
-            case 'c': comandoc(&sistema, current_language); break;
-            case 'l': comandol(&sistema, current_language); break;
-            case 'a': comandoa(&sistema, current_language); break;
-            case 'r': comandor(&sistema, current_language); break;
-            case 'd': comandod(&sistema, current_language); break;
-            case 'u': comandou(&sistema, current_language); break;
-            case 't': comandot(&sistema, current_language); break;
-            case 'v': comandov(&sistema); break;
-            default:  clearinput();break;
-        }   
-    }
-    /**
-     * @brief Ensure that memory is freed in case of wrong termination.
-     */
-    cleanupSistema(&sistema);
-    return 0;
-}
\ No newline at end of file
+/* iaed25 - ist1114613 - project */
+/**
+ * A program exemplifying a vaccine management system in C
+ * Each vaccine has a batch number, name, date, and quantity
+ * @file: project.c
+ * @author: ist1114613 (João Tamagnini)
+ */
+#include "headers.h"
+/**
+ * @brief Main function of the vaccination management program.
+ * 
+ * This function initializes the system, sets the language based on 
+ * command-line arguments, and enters a command-processing loop.
+ * 
+ * @param argc Number of command-line arguments.
+ * @param argv Array of command-line argument strings.
+ * 
+ * @return int Returns 0 on program termination.
+ */
+int main(int argc,const char *argv[]) {
+    char *current_language = "en";
+
+    /**
+     * @brief Read the command-line options: "pt" sets the language to
+     * Portuguese, "--max-lotes [n]" limits the number of batches
+     * (to MAX_LOTES when no number is given), "--snapshot <file>"
+     * loads the system from a snapshot file and "--journal <file>"
+     * keeps a journal of the commands that change the system, synced
+     * every "--sync-every <n>" records or "--sync-ms <t>" milliseconds
+     * (every record when neither is given). "--socket <path>" serves
+     * the commands of many clients on a Unix domain socket instead of
+     * reading them from stdin, with "--threads <n>" threads (one when
+     * not given). "--list-threads <n>" formats the large listings with
+     * n threads (one when not given). "--pipeline" reads the commands from stdin and writes
+     * their answers in threads of their own while they run.
+     */
+    int maxLotes = 0;
+    const char *ficheiroSnapshot = NULL;
+    const char *ficheiroJournal = NULL;
+    const char *caminhoSocket = NULL;
+    int numFios = 1, numFormatadores = 1;
+    int pipeline = 0;
+    int sincronizarCada = -1, sincronizarMs = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "pt") == 0) {
+            current_language = "pt";
+        } else if (strcmp(argv[i], "--max-lotes") == 0) {
+            maxLotes = MAX_LOTES;
+            if (i + 1 < argc && isdigit((unsigned char)argv[i + 1][0])) {
+                maxLotes = atoi(argv[++i]);
+            }
+        } else if (strcmp(argv[i], "--snapshot") == 0 && i + 1 < argc) {
+            ficheiroSnapshot = argv[++i];
+        } else if (strcmp(argv[i], "--journal") == 0 && i + 1 < argc) {
+            ficheiroJournal = argv[++i];
+        } else if (strcmp(argv[i], "--sync-every") == 0 && i + 1 < argc) {
+            sincronizarCada = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--sync-ms") == 0 && i + 1 < argc) {
+            sincronizarMs = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--socket") == 0 && i + 1 < argc) {
+            caminhoSocket = argv[++i];
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            numFios = atoi(argv[++i]);
+            if (numFios < 1) numFios = 1;
+            if (numFios > MAX_FIOS) numFios = MAX_FIOS;
+        } else if (strcmp(argv[i], "--list-threads") == 0 && i + 1 < argc) {
+            numFormatadores = atoi(argv[++i]);
+            if (numFormatadores < 1) numFormatadores = 1;
+            if (numFormatadores > MAX_FIOS) numFormatadores = MAX_FIOS;
+        } else if (strcmp(argv[i], "--pipeline") == 0) {
+            pipeline = 1;
+        }
+    }
+    if (sincronizarCada < 0) sincronizarCada = sincronizarMs > 0 ? 0 : 1;
+
+    /**
+     * @brief Initialize the vaccination system structure.
+     */
+    Sistema sistema;
+    Leitor leitor;
+    Saida saida;
+    Journal journal;
+    Estatisticas estatisticas;
+    Journal *journalAtivo = ficheiroJournal != NULL ? &journal : NULL;
+    if (!inicia_saida(&saida, STDOUT_FILENO, TAM_BLOCO_ESCRITA) ||
+        !inicia_sistema(&sistema, maxLotes) || !inicia_leitor(&leitor, stdin, &saida, journalAtivo) ||
+        !inicia_estatisticas(&estatisticas, caminhoSocket != NULL ? numFios : 1)) {
+        Error_exceeded_memory_capacity(&saida, current_language);
+        liberta_saida(&saida);
+        return 1;
+    }
+
+    /**
+     * @brief Load the snapshot and replay the journal on top of it.
+     */
+    long long posicaoJournal = 0;
+    int recuperado = 1;
+    if (ficheiroSnapshot != NULL &&
+        !carrega_snapshot(&sistema, ficheiroSnapshot, &posicaoJournal)) {
+        Error_load_snapshot(&saida, current_language);
+        recuperado = 0;
+    } else if (journalAtivo != NULL &&
+               (!recupera_journal(&sistema, ficheiroJournal, posicaoJournal, current_language) ||
+                !abre_journal(&journal, ficheiroJournal, sincronizarCada, sincronizarMs))) {
+        Error_load_journal(&saida, current_language);
+        recuperado = 0;
+    }
+    if (!recuperado) {
+        liberta_estatisticas(&estatisticas);
+        liberta_leitor(&leitor);
+        liberta_saida(&saida);
+        cleanupSistema(&sistema);
+        return 1;
+    }
+
+    /**
+     * @brief Start the threads that help format the large listings, which
+     * are formatted by their own thread only if the others cannot start.
+     */
+    if (numFormatadores > 1) inicia_formatadores(&sistema, numFormatadores - 1);
+
+    /**
+     * @brief Command processing loop. Reads commands from stdin and dispatches
+     * them with the rest of their line, recording the time each command takes.
+     * The end of a command is the start of the next one, so the clock is read
+     * once per command, unless the reader waited for more input in between.
+     * In server mode, the commands come from the clients of the socket instead.
+     * With the pipeline, they are read and answered in threads of their own, or
+     * in this loop if the threads cannot start.
+     */
+    int resultado = 0;
+    if (caminhoSocket != NULL) {
+        if (!serve_socket(caminhoSocket, numFios, &sistema, journalAtivo, &estatisticas,
+                          &saida, current_language)) {
+            Error_open_socket(&saida, current_language);
+            resultado = 1;
+        }
+    } else if (!pipeline || !executa_pipeline(&sistema, journalAtivo, &estatisticas, &leitor,
+                                              &saida, current_language)) {
+        int comando;
+        long long inicio = relogio_ns();
+        long long numLeituras = leitor.numLeituras;
+        while ((comando = le_comando(&leitor)) != EOF) {
+            if (comando == 'q') break;
+            char *linha = le_linha(&leitor);
+            if (leitor.numLeituras != numLeituras) inicio = relogio_ns();
+            processa_comando(&sistema, journalAtivo, &estatisticas, comando, linha, &saida,
+                             current_language);
+            long long fim = relogio_ns();
+            regista_latencia(&estatisticas, 0, comando, fim - inicio);
+            inicio = fim;
+            numLeituras = leitor.numLeituras;
+        }
+    }
+    /**
+     * @brief Free the memory on "q", at the end of the input or when the server stops.
+     */
+    if (journalAtivo != NULL) fecha_journal(journalAtivo);
+    liberta_estatisticas(&estatisticas);
+    liberta_leitor(&leitor);
+    liberta_saida(&saida);
+    cleanupSistema(&sistema);
+    return resultado;
+}
@@ -0,0 +1,428 @@
+/**
+ * Implementation of the server of the vaccination system, which runs
+ * the commands of many clients on a Unix domain socket.
+ * 
+ * Each thread of the server waits on an epoll instance of its own for
+ * new clients, for the commands of its clients and for their answers to
+ * be sent. The socket is in the epoll instances of all the threads, and
+ * each new client is accepted by one thread, which serves it from then
+ * on. Each client has its own buffer of input, where the lines are split
+ * in place like in a reader, and its own output, so its answers come
+ * back in the order of its commands. The commands of all the clients run
+ * against the same system, which the threads lock when there are more
+ * than one. Before each wait, the journal is written and then the
+ * answers, so an answer is never sent before its command is in the
+ * journal. The server stops on SIGINT or SIGTERM, which the main thread
+ * waits for, waking the threads of the server through an eventfd.
+ * @file: server_func.c
+ * @author: ist1114613 (João Tamagnini)
+ */
+#include "headers.h"
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+/**
+ * @brief Opens a Unix domain socket listening on a path, replacing
+ * the socket left there by a server that did not stop cleanly.
+ * 
+ * @param caminho Path of the socket.
+ * 
+ * @return The file descriptor of the socket, or -1 if it cannot be opened.
+ */
+static int abre_socket(const char *caminho) {
+    struct sockaddr_un endereco;
+    struct stat estado;
+    if (strlen(caminho) >= sizeof(endereco.sun_path)) return -1;
+    memset(&endereco, 0, sizeof(endereco));
+    endereco.sun_family = AF_UNIX;
+    strcpy(endereco.sun_path, caminho);
+    if (stat(caminho, &estado) == 0 && S_ISSOCK(estado.st_mode)) unlink(caminho);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+    if (bind(fd, (struct sockaddr *)&endereco, sizeof(endereco)) != 0 ||
+        listen(fd, MAX_PENDENTES) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * @brief Changes the events waited for on a client, if they changed.
+ * 
+ * @param trabalhador Pointer to the thread of the server.
+ * @param conexao Pointer to the client.
+ * @param eventos Events to wait for.
+ */
+static void vigia_conexao(Trabalhador *trabalhador, Conexao *conexao, unsigned int eventos) {
+    if (eventos == conexao->eventos) return;
+    struct epoll_event evento;
+    evento.events = eventos;
+    evento.data.ptr = conexao;
+    epoll_ctl(trabalhador->epoll, EPOLL_CTL_MOD, conexao->fd, &evento);
+    conexao->eventos = eventos;
+}
+
+/**
+ * @brief Closes a client and frees its memory. Its unsent answers are lost.
+ * 
+ * @param trabalhador Pointer to the thread of the server.
+ * @param conexao Pointer to the client.
+ */
+static void fecha_conexao(Trabalhador *trabalhador, Conexao *conexao) {
+    Conexao *ultima = trabalhador->conexoes[--trabalhador->numConexoes];
+    trabalhador->conexoes[conexao->posicao] = ultima;
+    ultima->posicao = conexao->posicao;
+    close(conexao->fd);
+    liberta_saida(&conexao->saida);
+    free(conexao->entrada);
+    free(conexao);
+}
+
+/**
+ * @brief Accepts a client waiting on the socket of the server, if
+ * another thread did not accept it first. A single client is accepted
+ * at a time, so that the clients are spread among the threads.
+ * 
+ * @param trabalhador Pointer to the thread of the server.
+ * 
+ * @note A client that cannot be kept for lack of memory is closed.
+ */
+static void aceita_conexao(Trabalhador *trabalhador) {
+    int fd = accept(trabalhador->fd, NULL, NULL);
+    if (fd >= 0) {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+        if (trabalhador->numConexoes == trabalhador->capacidadeConexoes) {
+            int capacidade = trabalhador->capacidadeConexoes > 0 ?
+                             2 * trabalhador->capacidadeConexoes : 16;
+            Conexao **conexoes =
+                (Conexao **)realloc(trabalhador->conexoes, capacidade * sizeof(Conexao *));
+            if (conexoes == NULL) {
+                close(fd);
+                return;
+            }
+            trabalhador->conexoes = conexoes;
+            trabalhador->capacidadeConexoes = capacidade;
+        }
+        Conexao *conexao = (Conexao *)malloc(sizeof(Conexao));
+        if (conexao == NULL) {
+            close(fd);
+            return;
+        }
+        conexao->fd = fd;
+        conexao->eventos = EPOLLIN;
+        conexao->capacidade = TAM_ENTRADA_CONEXAO;
+        conexao->entrada = (char *)malloc(conexao->capacidade);
+        conexao->inicio = conexao->fim = 0;
+        conexao->fimEntrada = conexao->emEspera = 0;
+        struct epoll_event evento;
+        evento.events = conexao->eventos;
+        evento.data.ptr = conexao;
+        if (!inicia_saida(&conexao->saida, fd, TAM_SAIDA_CONEXAO) || conexao->entrada == NULL ||
+            epoll_ctl(trabalhador->epoll, EPOLL_CTL_ADD, fd, &evento) != 0) {
+            liberta_saida(&conexao->saida);
+            free(conexao->entrada);
+            free(conexao);
+            close(fd);
+            return;
+        }
+        // The errors of all the clients are counted together, for "e".
+        conexao->saida.numErros = trabalhador->saida->numErros;
+        conexao->posicao = trabalhador->numConexoes;
+        trabalhador->conexoes[trabalhador->numConexoes++] = conexao;
+    }
+}
+
+/**
+ * @brief Reads what a client sent into its buffer, moving the commands
+ * not run yet to its start and growing it when they fill it.
+ * 
+ * @param conexao Pointer to the client.
+ * 
+ * @return 1 if successful, 0 if the client failed or there is no memory.
+ * 
+ * @note One byte of the buffer is always left free, so that the
+ * last line can be terminated even if it has no newline.
+ */
+static int le_conexao(Conexao *conexao) {
+    if (conexao->fimEntrada) return 1;
+    if (conexao->inicio > 0) {
+        memmove(conexao->entrada, conexao->entrada + conexao->inicio,
+                conexao->fim - conexao->inicio);
+        conexao->fim -= conexao->inicio;
+        conexao->inicio = 0;
+    }
+    if (conexao->fim == conexao->capacidade - 1) {
+        char *entrada = (char *)realloc(conexao->entrada, 2 * conexao->capacidade);
+        if (entrada == NULL) return 0;
+        conexao->entrada = entrada;
+        conexao->capacidade *= 2;
+    }
+    ssize_t lidos = read(conexao->fd, conexao->entrada + conexao->fim,
+                         conexao->capacidade - 1 - conexao->fim);
+    if (lidos > 0) {
+        conexao->fim += (int)lidos;
+    } else if (lidos == 0) {
+        conexao->fimEntrada = 1;
+    } else if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Gets the next command a client sent, skipping the whitespace
+ * before it, if its whole line was read.
+ * 
+ * @param conexao Pointer to the client.
+ * @param comando Where the letter of the command is stored.
+ * @param linha Where the rest of its line is stored, terminated in place
+ * in the buffer of the client. It stays valid until the client is read again.
+ * 
+ * @return 1 if there is a command, 0 otherwise.
+ */
+static int proximo_comando(Conexao *conexao, int *comando, char **linha) {
+    while (conexao->inicio < conexao->fim &&
+           isspace((unsigned char)conexao->entrada[conexao->inicio])) {
+        conexao->inicio++;
+    }
+    if (conexao->inicio == conexao->fim) return 0;
+    char *nova = memchr(conexao->entrada + conexao->inicio, '\n',
+                        conexao->fim - conexao->inicio);
+    if (nova == NULL) {
+        // The last line may not end with a newline.
+        if (!conexao->fimEntrada) return 0;
+        nova = conexao->entrada + conexao->fim;
+    }
+    *comando = (unsigned char)conexao->entrada[conexao->inicio];
+    *linha = conexao->entrada + conexao->inicio + 1;
+    *nova = '\0';
+    conexao->inicio = nova - conexao->entrada;
+    if (conexao->inicio < conexao->fim) conexao->inicio++;
+    return 1;
+}
+
+/**
+ * @brief Runs the commands a client sent, in order, recording the
+ * time each one takes. "q" ends the commands of the client only.
+ * 
+ * @param trabalhador Pointer to the thread of the server.
+ * @param conexao Pointer to the client.
+ * 
+ * @note The commands wait while the client has too many unsent answers.
+ */
+static void corre_conexao(Trabalhador *trabalhador, Conexao *conexao) {
+    int comando;
+    char *linha;
+    long long inicio = relogio_ns();
+    conexao->emEspera = 0;
+    while (proximo_comando(conexao, &comando, &linha)) {
+        if (comando == 'q') {
+            conexao->fimEntrada = 1;
+            conexao->inicio = conexao->fim;
+            break;
+        }
+        processa_comando(trabalhador->sistema, trabalhador->journal, trabalhador->estatisticas,
+                         comando, linha, &conexao->saida, trabalhador->current_language);
+        long long fim = relogio_ns();
+        regista_latencia(trabalhador->estatisticas, trabalhador->fio, comando, fim - inicio);
+        inicio = fim;
+        if (conexao->saida.tamanho >= LIMITE_SAIDA_CONEXAO) {
+            conexao->emEspera = 1;
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Sends the answers of a client and chooses what to wait for on
+ * it: more commands while it has few unsent answers, and being able to
+ * send while it has unsent answers or commands waiting for them to be
+ * sent. A client with nothing left to run or send after its input ends
+ * is closed.
+ * 
+ * @param trabalhador Pointer to the thread of the server.
+ * @param conexao Pointer to the client.
+ */
+static void atualiza_conexao(Trabalhador *trabalhador, Conexao *conexao) {
+    despeja_saida(&conexao->saida);
+    if (conexao->fimEntrada && !conexao->emEspera && conexao->saida.tamanho == 0) {
+        fecha_conexao(trabalhador, conexao);
+        return;
+    }
+    unsigned int eventos = 0;
+    if (!conexao->fimEntrada && !conexao->emEspera) eventos |= EPOLLIN;
+    if (conexao->emEspera || conexao->saida.tamanho > 0) eventos |= EPOLLOUT;
+    vigia_conexao(trabalhador, conexao, eventos);
+}
+
+/**
+ * @brief Handles the events of a client: sends its unsent answers, reads
+ * what it sent and runs its commands.
+ * 
+ * @param trabalhador Pointer to the thread of the server.
+ * @param conexao Pointer to the client.
+ * @param eventos Events that happened on the client.
+ * 
+ * @note A client that fails is closed.
+ */
+static void trata_conexao(Trabalhador *trabalhador, Conexao *conexao, unsigned int eventos) {
+    if (eventos & EPOLLOUT) despeja_saida(&conexao->saida);
+    if ((eventos & (EPOLLIN | EPOLLHUP | EPOLLERR)) && !le_conexao(conexao)) {
+        fecha_conexao(trabalhador, conexao);
+        return;
+    }
+    if (conexao->saida.tamanho < LIMITE_SAIDA_CONEXAO) corre_conexao(trabalhador, conexao);
+}
+
+/**
+ * @brief Serves the clients of a thread of the server until the server
+ * stops, and then closes them.
+ * 
+ * @param argumento Pointer to the thread of the server.
+ * 
+ * @return NULL.
+ */
+static void *trabalha(void *argumento) {
+    Trabalhador *trabalhador = (Trabalhador *)argumento;
+    struct epoll_event eventos[MAX_EVENTOS];
+    int parar = 0;
+    while (!parar) {
+        /* The previous commands are written to the journal and their
+            answers to the clients before waiting.*/
+        if (trabalhador->journal != NULL) despeja_journal(trabalhador->journal);
+        for (int i = trabalhador->numConexoes - 1; i >= 0; i--) {
+            atualiza_conexao(trabalhador, trabalhador->conexoes[i]);
+        }
+        int numEventos = epoll_wait(trabalhador->epoll, eventos, MAX_EVENTOS, -1);
+        if (numEventos < 0 && errno != EINTR) break;
+        for (int i = 0; i < numEventos; i++) {
+            if (eventos[i].data.ptr == &trabalhador->fd) {
+                aceita_conexao(trabalhador);
+            } else if (eventos[i].data.ptr == &trabalhador->parar) {
+                parar = 1;
+            } else {
+                trata_conexao(trabalhador, (Conexao *)eventos[i].data.ptr, eventos[i].events);
+            }
+        }
+    }
+
+    // The answers of the commands already run are sent before closing the clients.
+    if (trabalhador->journal != NULL) despeja_journal(trabalhador->journal);
+    while (trabalhador->numConexoes > 0) {
+        Conexao *conexao = trabalhador->conexoes[trabalhador->numConexoes - 1];
+        despeja_saida(&conexao->saida);
+        fecha_conexao(trabalhador, conexao);
+    }
+    free(trabalhador->conexoes);
+    trabalhador->conexoes = NULL;
+    return NULL;
+}
+
+/**
+ * @brief Prepares a thread of the server, with an epoll instance that
+ * waits for new clients and for the server to stop, and starts it.
+ * 
+ * @param trabalhador Pointer to the thread of the server, whose number,
+ * socket, eventfd and shared state are already set.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ * 
+ * @note Only one of the threads is woken for each new client, and all
+ * of them are woken to stop, since the eventfd is never read.
+ */
+static int inicia_trabalhador(Trabalhador *trabalhador) {
+    trabalhador->conexoes = NULL;
+    trabalhador->numConexoes = trabalhador->capacidadeConexoes = 0;
+    trabalhador->epoll = epoll_create1(EPOLL_CLOEXEC);
+    if (trabalhador->epoll < 0) return 0;
+    struct epoll_event evento;
+    evento.events = EPOLLIN | EPOLLEXCLUSIVE;
+    evento.data.ptr = &trabalhador->fd;
+    int ok = epoll_ctl(trabalhador->epoll, EPOLL_CTL_ADD, trabalhador->fd, &evento) == 0;
+    evento.events = EPOLLIN;
+    evento.data.ptr = &trabalhador->parar;
+    ok = ok && epoll_ctl(trabalhador->epoll, EPOLL_CTL_ADD, trabalhador->parar, &evento) == 0 &&
+         pthread_create(&trabalhador->thread, NULL, trabalha, trabalhador) == 0;
+    if (!ok) close(trabalhador->epoll);
+    return ok;
+}
+
+/**
+ * @brief Serves the commands of many clients on a Unix domain socket,
+ * with a number of threads, until SIGINT or SIGTERM is received.
+ * 
+ * @param caminho Path of the socket.
+ * @param numFios Number of threads that serve the clients.
+ * @param sistema Pointer to the vaccination system structure.
+ * @param journal Pointer to the journal, or NULL if there is none.
+ * @param estatisticas Pointer to the statistics of the commands, with
+ * room for the number of threads.
+ * @param saida Output whose counts of errors are shared by the clients.
+ * @param current_language Language for error messages.
+ * 
+ * @return 1 when the server stops, 0 if the socket cannot be opened.
+ * 
+ * @note The system and the journal are only locked when there is more
+ * than one thread.
+ */
+int serve_socket(const char *caminho, int numFios, Sistema *sistema, Journal *journal,
+                 Estatisticas *estatisticas, Saida *saida, char *current_language) {
+    /* The stop signals are blocked before the threads start, so only
+        sigwait gets them, and a client that leaves is noticed on write
+        instead of by SIGPIPE.*/
+    sigset_t sinais, sinaisAnteriores;
+    sigemptyset(&sinais);
+    sigaddset(&sinais, SIGINT);
+    sigaddset(&sinais, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &sinais, &sinaisAnteriores);
+    void (*tratamentoSigpipe)(int) = signal(SIGPIPE, SIG_IGN);
+
+    int fd = abre_socket(caminho);
+    int parar = eventfd(0, EFD_CLOEXEC);
+    Trabalhador *trabalhadores = (Trabalhador *)calloc(numFios, sizeof(Trabalhador));
+    int aberto = fd >= 0 && parar >= 0 && trabalhadores != NULL &&
+                 (numFios == 1 || inicia_bloqueios(sistema, journal));
+    int numIniciados = 0;
+    for (; aberto && numIniciados < numFios; numIniciados++) {
+        Trabalhador *trabalhador = &trabalhadores[numIniciados];
+        trabalhador->fio = numIniciados;
+        trabalhador->fd = fd;
+        trabalhador->parar = parar;
+        trabalhador->sistema = sistema;
+        trabalhador->journal = journal;
+        trabalhador->estatisticas = estatisticas;
+        trabalhador->saida = saida;
+        trabalhador->current_language = current_language;
+        aberto = inicia_trabalhador(trabalhador);
+    }
+    if (!aberto && numIniciados > 0) numIniciados--;
+    if (aberto) {
+        int sinal;
+        sigwait(&sinais, &sinal);
+    }
+
+    // Wake all the threads to stop, and wait for them to close their clients.
+    if (numIniciados > 0) eventfd_write(parar, 1);
+    for (int i = 0; i < numIniciados; i++) {
+        pthread_join(trabalhadores[i].thread, NULL);
+        close(trabalhadores[i].epoll);
+    }
+    liberta_bloqueios(sistema, journal);
+    free(trabalhadores);
+    if (parar >= 0) close(parar);
+    if (fd >= 0) {
+        close(fd);
+        unlink(caminho);
+    }
+    signal(SIGPIPE, tratamentoSigpipe);
+    pthread_sigmask(SIG_SETMASK, &sinaisAnteriores, NULL);
+    return aberto;
+}
@@ -0,0 +1,18 @@
+/**
+ * Declaration of the server of the vaccination system, which runs
+ * the commands of many clients on a Unix domain socket.
+ * @file: server_func.h
+ * @author: ist1114613 (João Tamagnini)
+ */
+#ifndef SERVER_FUNC_H
+#define SERVER_FUNC_H
+
+/// @defgroup server_funcs Server functions.
+/// @{
+
+/// Serves the commands of many clients on a Unix domain socket, with a number of threads.
+int serve_socket(const char *caminho, int numFios, Sistema *sistema, Journal *journal,
+                 Estatisticas *estatisticas, Saida *saida, char *current_language);
+
+/// @}
+#endif
@@ -0,0 +1,497 @@
+/**
+ * Implementation of the snapshots of the vaccination system.
+ * 
+ * A snapshot is a binary file with a header followed by the current
+ * date, the names of the vaccines, the batches as they are kept in
+ * their blocks, the names of the users of each shard, the inoculations
+ * and the table of the set of vaccinations of each shard. The arrays are written and read in bulk,
+ * and the indexes and heaps that hold pointers are rebuilt on loading.
+ * @file: snapshot_func.c
+ * @author: ist1114613 (João Tamagnini)
+ */
+#include "headers.h"
+
+/**
+ * @brief Writes an array to a snapshot file.
+ * 
+ * @param f Snapshot file.
+ * @param dados Pointer to the array.
+ * @param tamanho Number of bytes of the array.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+static int escreve_dados(FILE *f, const void *dados, size_t tamanho) {
+    return tamanho == 0 || fwrite(dados, 1, tamanho, f) == tamanho;
+}
+
+/**
+ * @brief Reads an array from a snapshot file.
+ * 
+ * @param f Snapshot file.
+ * @param dados Pointer to the array.
+ * @param tamanho Number of bytes of the array.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+static int le_dados(FILE *f, void *dados, size_t tamanho) {
+    return tamanho == 0 || fread(dados, 1, tamanho, f) == tamanho;
+}
+
+/**
+ * @brief Gets the name of a vaccine or of a user.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param fatia Shard of the user, -1 for the name of a vaccine.
+ * @param id Id of the vaccine, or position of the user in its shard.
+ * 
+ * @return The name.
+ */
+static const char *nome_snapshot(Sistema *sistema, int fatia, int id) {
+    return fatia >= 0 ? sistema->fatiasUtentes[fatia].utentes[id].nome :
+                        sistema->vacinas[id].nome;
+}
+
+/**
+ * @brief Writes the names of the vaccines or of the users of a shard
+ * to a snapshot file, as their number and total size followed by the
+ * names with their terminators, in the order of their ids.
+ * 
+ * @param f Snapshot file.
+ * @param sistema Pointer to the vaccination system structure.
+ * @param fatia Shard whose users are written, -1 for the vaccines.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+static int escreve_nomes(FILE *f, Sistema *sistema, int fatia) {
+    int numNomes = fatia >= 0 ? sistema->fatiasUtentes[fatia].numUtentes : sistema->numVacinas;
+    long long total = 0;
+    for (int i = 0; i < numNomes; i++) {
+        total += strlen(nome_snapshot(sistema, fatia, i)) + 1;
+    }
+    int ok = escreve_dados(f, &numNomes, sizeof(int)) &&
+             escreve_dados(f, &total, sizeof(long long));
+    for (int i = 0; ok && i < numNomes; i++) {
+        const char *nome = nome_snapshot(sistema, fatia, i);
+        ok = escreve_dados(f, nome, strlen(nome) + 1);
+    }
+    return ok;
+}
+
+/**
+ * @brief Writes the inoculations to a snapshot file in the order they
+ * were added, with a single write for each run of them that follow
+ * each other in a segment. They are loaded into the first positions,
+ * so the positions left by deleted inoculations are not saved, nor the
+ * deleted inoculations that listings still running show.
+ * 
+ * @param f Snapshot file.
+ * @param sistema Pointer to the vaccination system structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+static int escreve_inoculacoes(FILE *f, Sistema *sistema) {
+    int ok = 1;
+    for (int inicio = sistema->primeiraInoculacao; ok && inicio != -1; ) {
+        int fim = inicio;
+        Inoculacao *inoculacao = obtem_inoculacao(sistema, fim);
+        if (inoculacao->apagada != VERSAO_VIVA) {
+            inicio = inoculacao->seguinte;
+            continue;
+        }
+        while (inoculacao->seguinte == fim + 1 &&
+               (fim + 1) % INOCULACOES_POR_SEGMENTO != 0 &&
+               obtem_inoculacao(sistema, fim + 1)->apagada == VERSAO_VIVA) {
+            inoculacao = obtem_inoculacao(sistema, ++fim);
+        }
+        ok = escreve_dados(f, obtem_inoculacao(sistema, inicio),
+                           (fim - inicio + 1) * sizeof(Inoculacao));
+        inicio = inoculacao->seguinte;
+    }
+    return ok;
+}
+
+/**
+ * @brief Reads the names of the vaccines or of the users from a
+ * snapshot file in a single read.
+ * 
+ * @param f Snapshot file.
+ * @param numNomes Pointer where the number of names is stored.
+ * 
+ * @return The names one after the other, which the caller frees,
+ * or NULL if they cannot be read.
+ */
+static char *le_nomes(FILE *f, int *numNomes) {
+    long long total;
+    if (!le_dados(f, numNomes, sizeof(int)) || !le_dados(f, &total, sizeof(long long)) ||
+        *numNomes < 0 || total < *numNomes) {
+        return NULL;
+    }
+    char *nomes = (char *)malloc(total + 1);
+    if (nomes == NULL || !le_dados(f, nomes, total)) {
+        free(nomes);
+        return NULL;
+    }
+
+    // Check that the names end where the size says.
+    int terminadores = 0;
+    for (char *c = nomes; (c = memchr(c, '\0', nomes + total - c)) != NULL; c++) {
+        terminadores++;
+    }
+    if (terminadores != *numNomes || (total > 0 && nomes[total - 1] != '\0')) {
+        free(nomes);
+        return NULL;
+    }
+    return nomes;
+}
+
+/**
+ * @brief Sizes an empty name index for a number of names, so that
+ * it does not grow while they are registered.
+ * 
+ * @param indice Pointer to the empty name index.
+ * @param numNomes Number of names.
+ * 
+ * @return 1 if successful, 0 if there is no memory.
+ */
+static int reserva_indice_nomes(IndiceNomes *indice, int numNomes) {
+    int capacidade = TAM_INICIAL_INDICE;
+    while (capacidade < 2 * (numNomes + 1)) capacidade *= 2;
+    liberta_indice_nomes(indice);
+    return inicia_indice_nomes(indice, capacidade);
+}
+
+/**
+ * @brief Counts the batch slots retired while listings run, which are
+ * saved as free slots, since no listing runs once the snapshot is loaded.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * 
+ * @return The number of batch slots retired.
+ * 
+ * @note The system must be locked alone, so nothing is retired or reused
+ * until the snapshot is saved.
+ */
+static int conta_lotes_retirados(Sistema *sistema) {
+    Versoes *versoes = &sistema->versoes;
+    int numRetirados = 0;
+    bloqueia(&versoes->bloqueio, sistema->concorrente);
+    for (int i = 0; i < versoes->numRetirados; i++) {
+        numRetirados += versoes->retirados[i].tipo == RETIRADO_LOTE;
+    }
+    desbloqueia(&versoes->bloqueio, sistema->concorrente);
+    return numRetirados;
+}
+
+/**
+ * @brief Writes the free batch slots to a snapshot file, followed by
+ * those retired while listings run.
+ * 
+ * @param f Snapshot file.
+ * @param sistema Pointer to the vaccination system structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ * 
+ * @note The system must be locked alone.
+ */
+static int escreve_lotes_livres(FILE *f, Sistema *sistema) {
+    Versoes *versoes = &sistema->versoes;
+    int ok = escreve_dados(f, sistema->lotesLivres, sistema->numLotesLivres * sizeof(int));
+    bloqueia(&versoes->bloqueio, sistema->concorrente);
+    for (int i = 0; ok && i < versoes->numRetirados; i++) {
+        if (versoes->retirados[i].tipo == RETIRADO_LOTE) {
+            ok = escreve_dados(f, &versoes->retirados[i].pos, sizeof(int));
+        }
+    }
+    desbloqueia(&versoes->bloqueio, sistema->concorrente);
+    return ok;
+}
+
+/**
+ * @brief Saves the whole system to a snapshot file. The file is
+ * written under a temporary name and then renamed, so an interrupted
+ * save never replaces a good snapshot.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param ficheiro Name of the snapshot file.
+ * @param posicaoJournal Position of the journal the snapshot includes.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+int guarda_snapshot(Sistema *sistema, const char *ficheiro, long long posicaoJournal) {
+    char *temporario = (char *)malloc(strlen(ficheiro) + 5);
+    if (temporario == NULL) return 0;
+    sprintf(temporario, "%s.tmp", ficheiro);
+    FILE *f = fopen(temporario, "wb");
+    if (f == NULL) {
+        free(temporario);
+        return 0;
+    }
+    CabecalhoSnapshot cabecalho;
+    memset(&cabecalho, 0, sizeof(cabecalho));
+    strcpy(cabecalho.magica, SNAPSHOT_MAGICA);
+    cabecalho.versao = SNAPSHOT_VERSAO;
+    cabecalho.tamanhoLote = sizeof(Lote);
+    cabecalho.tamanhoInoculacao = sizeof(Inoculacao);
+    cabecalho.tamanhoChave = sizeof(ChaveVacinacao);
+    cabecalho.posicaoJournal = posicaoJournal;
+    int ok = escreve_dados(f, &cabecalho, sizeof(cabecalho)) &&
+             escreve_dados(f, &sistema->data_atual, sizeof(Data));
+
+    // The vaccines are registered again in the same order, so they keep their ids.
+    ok = ok && escreve_nomes(f, sistema, -1);
+
+    // The batches keep their slots, because the inoculations refer to them.
+    int contagens[] = { sistema->topoLotes, sistema->numLotes,
+                        sistema->numLotesLivres + conta_lotes_retirados(sistema) };
+    ok = ok && escreve_dados(f, contagens, sizeof(contagens));
+    for (int i = 0; ok && i < sistema->topoLotes; i += LOTES_POR_BLOCO) {
+        int numLotes = sistema->topoLotes - i < LOTES_POR_BLOCO ?
+                       sistema->topoLotes - i : LOTES_POR_BLOCO;
+        ok = escreve_dados(f, obtem_lote(sistema, i), numLotes * sizeof(Lote));
+    }
+    ok = ok && escreve_dados(f, sistema->ordemLotes, sistema->numLotes * sizeof(int)) &&
+         escreve_lotes_livres(f, sistema);
+
+    // The users of each shard, the inoculations and the set of vaccinations of each shard.
+    for (int i = 0; ok && i < NUM_FATIAS; i++) {
+        ok = escreve_nomes(f, sistema, i);
+    }
+    ok = ok && escreve_dados(f, &sistema->numInoculacoes, sizeof(int)) &&
+         escreve_inoculacoes(f, sistema);
+    for (int i = 0; ok && i < NUM_FATIAS; i++) {
+        ConjuntoVacinacoes *vacinacoes = &sistema->fatiasUtentes[i].vacinacoes;
+        ok = escreve_dados(f, &vacinacoes->capacidade, sizeof(int)) &&
+             escreve_dados(f, &vacinacoes->tamanho, sizeof(int)) &&
+             escreve_dados(f, vacinacoes->chaves,
+                           vacinacoes->capacidade * sizeof(ChaveVacinacao));
+    }
+
+    if (fclose(f) != 0) ok = 0;
+    if (!ok || rename(temporario, ficheiro) != 0) {
+        remove(temporario);
+        ok = 0;
+    }
+    free(temporario);
+    return ok;
+}
+
+/**
+ * @brief Checks that the slots of the batches and the free slots read
+ * from a snapshot file are all slots of the storage, each listed once.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param numLotes Number of slots of batches, in ordemLotes.
+ * @param numLivres Number of free slots, in lotesLivres.
+ * 
+ * @return 1 if valid, 0 if not or if there is no memory to check them.
+ */
+static int valida_slots_lotes(Sistema *sistema, int numLotes, int numLivres) {
+    char *listados = (char *)calloc(sistema->topoLotes + 1, 1);
+    int ok = listados != NULL;
+    for (int i = 0; ok && i < numLotes + numLivres; i++) {
+        int slot = i < numLotes ? sistema->ordemLotes[i] : sistema->lotesLivres[i - numLotes];
+        ok = slot >= 0 && slot < sistema->topoLotes && !listados[slot];
+        if (ok) listados[slot] = 1;
+    }
+    free(listados);
+    return ok;
+}
+
+/**
+ * @brief Loads the batches of a snapshot file into their slots and
+ * rebuilds the batch index and the heaps of the vaccines.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param f Snapshot file.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+static int carrega_lotes(Sistema *sistema, FILE *f) {
+    // A slot that could not be retired for lack of memory is neither a batch nor free.
+    int contagens[3];
+    if (!le_dados(f, contagens, sizeof(contagens)) || contagens[0] < 0 ||
+        contagens[1] < 0 || contagens[2] < 0 || contagens[1] + contagens[2] > contagens[0] ||
+        !reserva_lotes(sistema, contagens[0])) {
+        return 0;
+    }
+    sistema->topoLotes = contagens[0];
+    for (int i = 0; i < sistema->topoLotes; i += LOTES_POR_BLOCO) {
+        int numLotes = sistema->topoLotes - i < LOTES_POR_BLOCO ?
+                       sistema->topoLotes - i : LOTES_POR_BLOCO;
+        if (!le_dados(f, obtem_lote(sistema, i), numLotes * sizeof(Lote))) return 0;
+    }
+    if (!le_dados(f, sistema->ordemLotes, contagens[1] * sizeof(int)) ||
+        !le_dados(f, sistema->lotesLivres, contagens[2] * sizeof(int)) ||
+        !valida_slots_lotes(sistema, contagens[1], contagens[2])) {
+        return 0;
+    }
+    sistema->numLotesLivres = contagens[2];
+
+    // Index the batches and put the ones that were in a heap back in it.
+    for (int i = 0; i < contagens[1]; i++) {
+        int slot = sistema->ordemLotes[i];
+        Lote *lote = obtem_lote(sistema, slot);
+        if (lote->vacina < 0 || lote->vacina >= sistema->numVacinas ||
+            !insere_indice_lote(sistema, slot)) {
+            return 0;
+        }
+        sistema->numLotes++;
+        int estavaNoHeap = lote->posHeap != -1;
+        lote->posHeap = -1;
+        if (estavaNoHeap && !insere_heap_lote(sistema, slot)) return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Loads the users of a shard of a snapshot file, registering
+ * them in their original order so they keep their ids.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param f Snapshot file.
+ * @param numero Number of the shard.
+ * 
+ * @return 1 if successful, 0 otherwise, also if a user is not in the shard.
+ */
+static int carrega_utentes(Sistema *sistema, FILE *f, int numero) {
+    FatiaUtentes *fatia = &sistema->fatiasUtentes[numero];
+    int numNomes = 0;
+    char *nomes = le_nomes(f, &numNomes);
+    int ok = nomes != NULL && reserva_indice_nomes(&fatia->indice, numNomes);
+    if (ok && numNomes > 0) {
+        Utente *utentes = (Utente *)realloc(fatia->utentes, numNomes * sizeof(Utente));
+        ok = utentes != NULL;
+        if (ok) {
+            fatia->utentes = utentes;
+            fatia->capacidadeUtentes = numNomes;
+        }
+    }
+    for (char *nome = nomes; ok && numNomes-- > 0; nome += strlen(nome) + 1) {
+        int id = (fatia->numUtentes << BITS_FATIAS) | numero;
+        ok = regista_utente(sistema, nome) == id;
+    }
+    free(nomes);
+    return ok;
+}
+
+/**
+ * @brief Loads the inoculations of a snapshot file and rebuilds
+ * the lists of inoculations of the users.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param f Snapshot file.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+static int carrega_inoculacoes(Sistema *sistema, FILE *f) {
+    int numInoculacoes;
+    if (!le_dados(f, &numInoculacoes, sizeof(int)) || numInoculacoes < 0 ||
+        !reserva_inoculacoes(sistema, numInoculacoes)) {
+        return 0;
+    }
+    for (int i = 0; i < numInoculacoes; i += INOCULACOES_POR_SEGMENTO) {
+        int numLidas = numInoculacoes - i < INOCULACOES_POR_SEGMENTO ?
+                       numInoculacoes - i : INOCULACOES_POR_SEGMENTO;
+        if (!le_dados(f, obtem_inoculacao(sistema, i), numLidas * sizeof(Inoculacao))) return 0;
+    }
+
+    // Count the inoculations of each user to size their lists only once.
+    for (int i = 0; i < numInoculacoes; i++) {
+        Inoculacao *inoculacao = obtem_inoculacao(sistema, i);
+        if (inoculacao->utente < 0 ||
+            inoculacao->utente >> BITS_FATIAS >=
+                obtem_fatia_utentes(sistema, inoculacao->utente)->numUtentes ||
+            inoculacao->lote < 0 || inoculacao->lote >= sistema->topoLotes) {
+            return 0;
+        }
+        obtem_utente(sistema, inoculacao->utente)->numInoculacoes++;
+    }
+    for (int f = 0; f < NUM_FATIAS; f++) {
+        FatiaUtentes *fatia = &sistema->fatiasUtentes[f];
+        for (int i = 0; i < fatia->numUtentes; i++) {
+            Utente *u = &fatia->utentes[i];
+            if (u->numInoculacoes > u->capacidadeInoculacoes) {
+                int *novas = (int *)realloc(u->inoculacoes, u->numInoculacoes * sizeof(int));
+                if (novas == NULL) return 0;
+                u->inoculacoes = novas;
+                u->capacidadeInoculacoes = u->numInoculacoes;
+            }
+        }
+    }
+    encadeia_inoculacoes(sistema, numInoculacoes);
+    reconstroi_inoculacoes_utentes(sistema);
+    return 1;
+}
+
+/**
+ * @brief Loads the set of vaccinations of a shard of a snapshot file as it was kept.
+ * 
+ * @param conjunto Pointer to the empty set of vaccinations of the shard.
+ * @param f Snapshot file.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+static int carrega_vacinacoes(ConjuntoVacinacoes *conjunto, FILE *f) {
+    int capacidade, tamanho;
+    if (!le_dados(f, &capacidade, sizeof(int)) || !le_dados(f, &tamanho, sizeof(int)) ||
+        capacidade < 0 || (capacidade & (capacidade - 1)) != 0 || tamanho < 0 ||
+        2 * tamanho > capacidade) {
+        return 0;
+    }
+    if (capacidade == 0) return 1;
+    conjunto->chaves = (ChaveVacinacao *)malloc(capacidade * sizeof(ChaveVacinacao));
+    if (conjunto->chaves == NULL) return 0;
+    conjunto->capacidade = capacidade;
+    conjunto->tamanho = tamanho;
+    return le_dados(f, conjunto->chaves, capacidade * sizeof(ChaveVacinacao));
+}
+
+/**
+ * @brief Loads the system from a snapshot file.
+ * 
+ * @param sistema Pointer to a vaccination system that was just initialized.
+ * @param ficheiro Name of the snapshot file.
+ * @param posicaoJournal Pointer where the position of the journal the
+ * snapshot includes is stored, 0 if the file does not exist.
+ * 
+ * @return 1 if successful or if the file does not exist, in which
+ * case the system stays empty, 0 otherwise.
+ * 
+ * @note If the loading fails the system may be partially loaded,
+ * so it must only be cleaned up.
+ */
+int carrega_snapshot(Sistema *sistema, const char *ficheiro, long long *posicaoJournal) {
+    *posicaoJournal = 0;
+    FILE *f = fopen(ficheiro, "rb");
+    if (f == NULL) return errno == ENOENT;
+
+    // Check that the file is a snapshot written in the same format.
+    CabecalhoSnapshot cabecalho;
+    int ok = le_dados(f, &cabecalho, sizeof(cabecalho)) &&
+             memcmp(cabecalho.magica, SNAPSHOT_MAGICA, sizeof(cabecalho.magica)) == 0 &&
+             cabecalho.versao == SNAPSHOT_VERSAO &&
+             cabecalho.tamanhoLote == (int)sizeof(Lote) &&
+             cabecalho.tamanhoInoculacao == (int)sizeof(Inoculacao) &&
+             cabecalho.tamanhoChave == (int)sizeof(ChaveVacinacao) &&
+             le_dados(f, &sistema->data_atual, sizeof(Data));
+    if (ok) *posicaoJournal = cabecalho.posicaoJournal;
+
+    // Register the vaccines and the users in their original order.
+    int numNomes = 0;
+    char *nomes = ok ? le_nomes(f, &numNomes) : NULL;
+    ok = nomes != NULL;
+    for (char *nome = nomes; ok && numNomes-- > 0; nome += strlen(nome) + 1) {
+        ok = regista_vacina(sistema, nome) != -1;
+    }
+    free(nomes);
+    ok = ok && carrega_lotes(sistema, f);
+    for (int i = 0; ok && i < NUM_FATIAS; i++) {
+        ok = carrega_utentes(sistema, f, i);
+    }
+    ok = ok && carrega_inoculacoes(sistema, f);
+    for (int i = 0; ok && i < NUM_FATIAS; i++) {
+        ok = carrega_vacinacoes(&sistema->fatiasUtentes[i].vacinacoes, f);
+    }
+    fclose(f);
+    return ok;
+}
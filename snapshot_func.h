@@ -0,0 +1,20 @@
+/**
+ * Declarations for the snapshots of the vaccination system.
+ * @file: snapshot_func.h
+ * @author: ist1114613 (João Tamagnini)
+ */
+#ifndef SNAPSHOT_FUNC_H
+#define SNAPSHOT_FUNC_H
+#include "headers.h"
+
+/// @defgroup snapshot_funcs Snapshot functions.
+/// @{
+
+/// Saves the whole system to a snapshot file.
+int guarda_snapshot(Sistema *sistema, const char *ficheiro, long long posicaoJournal);
+
+/// Loads the system from a snapshot file.
+int carrega_snapshot(Sistema *sistema, const char *ficheiro, long long *posicaoJournal);
+
+/// @}
+#endif
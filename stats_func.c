@@ -0,0 +1,187 @@
+/**
+ * Implementation of the statistics of the commands run by the
+ * vaccination system.
+ * 
+ * The latencies of each command letter are kept in a log-linear
+ * histogram, like HdrHistogram: each power of two of nanoseconds is
+ * split in 2^BITS_SUBBALDES buckets, so a latency is recorded with a
+ * few shifts and the percentiles are off by at most 1/2^BITS_SUBBALDES.
+ * Each thread of the server records its commands in histograms of its
+ * own, with relaxed atomic stores so that "e" can read them from another
+ * thread, and the histograms of all the threads are merged when printed.
+ * @file: stats_func.c
+ * @author: ist1114613 (João Tamagnini)
+ */
+#include "headers.h"
+#include <time.h>
+
+/**
+ * @brief Initializes the statistics of the commands, with no command run.
+ * 
+ * @param estatisticas Pointer to the statistics.
+ * @param numFios Number of threads that record commands.
+ * 
+ * @return 1 if successful, 0 if there is no memory.
+ */
+int inicia_estatisticas(Estatisticas *estatisticas, int numFios) {
+    estatisticas->numFios = numFios;
+    estatisticas->comandos = (LatenciasComando *)calloc((size_t)numFios * NUM_LETRAS_COMANDO,
+                                                       sizeof(LatenciasComando));
+    return estatisticas->comandos != NULL;
+}
+
+/**
+ * @brief Gets the current time in nanoseconds.
+ * 
+ * @return The nanoseconds since an arbitrary point.
+ */
+long long relogio_ns(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (long long)t.tv_sec * 1000000000 + t.tv_nsec;
+}
+
+/**
+ * @brief Gets the bucket of a latency. The latencies below
+ * 2^(BITS_SUBBALDES + 1) have a bucket each, and the others share
+ * the bucket of their BITS_SUBBALDES + 1 highest bits.
+ * 
+ * @param ns Latency in nanoseconds.
+ * 
+ * @return The index of the bucket.
+ */
+static int balde_latencia(long long ns) {
+    unsigned long long valor = ns > 0 ? (unsigned long long)ns : 0;
+    if (valor >= 1ull << BITS_LATENCIA) valor = (1ull << BITS_LATENCIA) - 1;
+    if (valor < 2ull << BITS_SUBBALDES) return (int)valor;
+    int deslocamento = 63 - __builtin_clzll(valor) - BITS_SUBBALDES;
+    return ((deslocamento + 1) << BITS_SUBBALDES) + (int)(valor >> deslocamento) -
+           (1 << BITS_SUBBALDES);
+}
+
+/**
+ * @brief Gets the largest latency of a bucket.
+ * 
+ * @param balde Index of the bucket.
+ * 
+ * @return The latency in nanoseconds.
+ */
+static long long limite_balde(int balde) {
+    if (balde < 2 << BITS_SUBBALDES) return balde;
+    int deslocamento = (balde >> BITS_SUBBALDES) - 1;
+    long long topo = (balde & ((1 << BITS_SUBBALDES) - 1)) + (1 << BITS_SUBBALDES);
+    return ((topo + 1) << deslocamento) - 1;
+}
+
+/**
+ * @brief Adds to a counter that only one thread changes, but that
+ * others may read at the same time.
+ * 
+ * @param contador Pointer to the counter.
+ * @param valor Value to add.
+ */
+static void soma_contador(long long *contador, long long valor) {
+    __atomic_store_n(contador, __atomic_load_n(contador, __ATOMIC_RELAXED) + valor,
+                     __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Records the latency of a command run by a thread. Commands
+ * that are not lowercase letters are not recorded.
+ * 
+ * @param estatisticas Pointer to the statistics.
+ * @param fio Number of the thread, 0 if there is only one.
+ * @param comando Letter of the command.
+ * @param ns Latency of the command in nanoseconds.
+ */
+void regista_latencia(Estatisticas *estatisticas, int fio, int comando, long long ns) {
+    if (comando < 'a' || comando > 'z') return;
+    LatenciasComando *latencias =
+        &estatisticas->comandos[fio * NUM_LETRAS_COMANDO + comando - 'a'];
+    soma_contador(&latencias->numComandos, 1);
+    soma_contador(&latencias->totalNs, ns);
+    if (ns > latencias->maximoNs) __atomic_store_n(&latencias->maximoNs, ns, __ATOMIC_RELAXED);
+    soma_contador(&latencias->baldes[balde_latencia(ns)], 1);
+}
+
+/**
+ * @brief Adds the latencies of a command recorded by a thread to those
+ * of the other threads.
+ * 
+ * @param soma Pointer to the latencies of the command in all the threads.
+ * @param latencias Pointer to the latencies of the command in a thread.
+ */
+static void junta_latencias(LatenciasComando *soma, const LatenciasComando *latencias) {
+    soma->numComandos += __atomic_load_n(&latencias->numComandos, __ATOMIC_RELAXED);
+    soma->totalNs += __atomic_load_n(&latencias->totalNs, __ATOMIC_RELAXED);
+    long long maximoNs = __atomic_load_n(&latencias->maximoNs, __ATOMIC_RELAXED);
+    if (maximoNs > soma->maximoNs) soma->maximoNs = maximoNs;
+    for (int i = 0; i < NUM_BALDES_LATENCIA; i++) {
+        soma->baldes[i] += __atomic_load_n(&latencias->baldes[i], __ATOMIC_RELAXED);
+    }
+}
+
+/**
+ * @brief Gets a percentile of the latencies of a command.
+ * 
+ * @param latencias Pointer to the latencies of the command.
+ * @param porMil Percentile, in thousandths (e.g. 990 for p99).
+ * 
+ * @return The largest latency of the bucket of the percentile, in
+ * nanoseconds, but never more than the maximum latency.
+ */
+static long long percentil(const LatenciasComando *latencias, int porMil) {
+    long long ordem = (latencias->numComandos * porMil + 999) / 1000;
+    long long acumulado = 0;
+    for (int i = 0; i < NUM_BALDES_LATENCIA; i++) {
+        acumulado += latencias->baldes[i];
+        if (acumulado >= ordem) {
+            long long limite = limite_balde(i);
+            return limite < latencias->maximoNs ? limite : latencias->maximoNs;
+        }
+    }
+    return latencias->maximoNs;
+}
+
+/**
+ * @brief Prints the statistics of each command run by all the threads,
+ * as "<letter> <count> <total> <p50> <p99> <p999> <max>" lines, with
+ * the latencies in nanoseconds.
+ * 
+ * @param estatisticas Pointer to the statistics.
+ * @param saida Output where the statistics are written.
+ */
+void escreve_estatisticas(Estatisticas *estatisticas, Saida *saida) {
+    static const int percentis[] = { 500, 990, 999 };
+    LatenciasComando soma;
+    const LatenciasComando *latencias = &soma;
+    for (int letra = 0; letra < NUM_LETRAS_COMANDO; letra++) {
+        memset(&soma, 0, sizeof(soma));
+        for (int fio = 0; fio < estatisticas->numFios; fio++) {
+            junta_latencias(&soma, &estatisticas->comandos[fio * NUM_LETRAS_COMANDO + letra]);
+        }
+        if (latencias->numComandos == 0) continue;
+        escreve_caracter(saida, (char)('a' + letra));
+        escreve_caracter(saida, ' ');
+        escreve_longo(saida, latencias->numComandos);
+        escreve_caracter(saida, ' ');
+        escreve_longo(saida, latencias->totalNs);
+        for (int i = 0; i < 3; i++) {
+            escreve_caracter(saida, ' ');
+            escreve_longo(saida, percentil(latencias, percentis[i]));
+        }
+        escreve_caracter(saida, ' ');
+        escreve_longo(saida, latencias->maximoNs);
+        escreve_caracter(saida, '\n');
+    }
+}
+
+/**
+ * @brief Frees the statistics of the commands.
+ * 
+ * @param estatisticas Pointer to the statistics.
+ */
+void liberta_estatisticas(Estatisticas *estatisticas) {
+    free(estatisticas->comandos);
+    estatisticas->comandos = NULL;
+}
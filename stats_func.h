@@ -0,0 +1,29 @@
+/**
+ * Declaration of the functions that keep the statistics of the
+ * commands run by the vaccination system.
+ * @file: stats_func.h
+ * @author: ist1114613 (João Tamagnini)
+ */
+#ifndef STATS_FUNC_H
+#define STATS_FUNC_H
+
+/// @defgroup stats_funcs Statistics functions.
+/// @{
+
+/// Initializes the statistics of the commands.
+int inicia_estatisticas(Estatisticas *estatisticas, int numFios);
+
+/// Gets the current time in nanoseconds.
+long long relogio_ns(void);
+
+/// Records the latency of a command.
+void regista_latencia(Estatisticas *estatisticas, int fio, int comando, long long ns);
+
+/// Prints the statistics of the commands.
+void escreve_estatisticas(Estatisticas *estatisticas, Saida *saida);
+
+/// Frees the statistics of the commands.
+void liberta_estatisticas(Estatisticas *estatisticas);
+
+/// @}
+#endif
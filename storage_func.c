@@ -0,0 +1,339 @@
+/**
+ * Implementation of the storage of the batches, the inoculations
+ * and the names of the vaccination system.
+ * 
+ * All are kept in fixed-size blocks that are never moved, so growing
+ * them allocates one more block instead of copying everything, and the
+ * memory taken grows with the number of records. The positions of
+ * deleted batches and inoculations are reused by new ones, once no
+ * listing can read them. The arrays of blocks are copied when they
+ * grow, and the old copies kept while listings may read them.
+ * @file: storage_func.c
+ * @author: ist1114613 (João Tamagnini)
+ */
+#include "headers.h"
+
+/**
+ * @brief Adds a new block of batches to the system, growing the
+ * arrays that hold batch slots so that they can hold every slot.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * 
+ * @return 1 if successful, 0 if there is no memory.
+ * 
+ * @note The batches already in the system are not moved, so pointers
+ * to them stay valid.
+ */
+static int novo_bloco_lotes(Sistema *sistema) {
+    int capacidade = sistema->capacidadeLotes + LOTES_POR_BLOCO;
+
+    // Grow the array of blocks, doubling it when full.
+    if (sistema->numBlocosLotes == sistema->capacidadeBlocosLotes) {
+        int numBlocos = sistema->capacidadeBlocosLotes ? 2 * sistema->capacidadeBlocosLotes : 4;
+        if (!cresce_memoria(sistema, (void **)&sistema->blocosLotes,
+                            sistema->numBlocosLotes * sizeof(Lote *),
+                            numBlocos * sizeof(Lote *))) {
+            return 0;
+        }
+        sistema->capacidadeBlocosLotes = numBlocos;
+    }
+
+    // Grow the sorted order and the free slots to the new capacity.
+    int *ordem = (int *)realloc(sistema->ordemLotes, capacidade * sizeof(int));
+    if (ordem == NULL) return 0;
+    sistema->ordemLotes = ordem;
+    int *livres = (int *)realloc(sistema->lotesLivres, capacidade * sizeof(int));
+    if (livres == NULL) return 0;
+    sistema->lotesLivres = livres;
+
+    // Allocate the new block.
+    Lote *bloco = (Lote *)malloc(LOTES_POR_BLOCO * sizeof(Lote));
+    if (bloco == NULL) return 0;
+    sistema->blocosLotes[sistema->numBlocosLotes++] = bloco;
+    sistema->capacidadeLotes = capacidade;
+    return 1;
+}
+
+/**
+ * @brief Gets a free slot for a new batch, reusing the slots
+ * of removed batches first.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * 
+ * @return The slot for the new batch, -1 if there is no memory.
+ */
+int novo_slot_lote(Sistema *sistema) {
+    if (sistema->numLotesLivres > 0) {
+        return sistema->lotesLivres[--sistema->numLotesLivres];
+    }
+    if (sistema->topoLotes == sistema->capacidadeLotes && !novo_bloco_lotes(sistema)) {
+        return -1;
+    }
+    return sistema->topoLotes++;
+}
+
+/**
+ * @brief Makes room for a number of batch slots, without using them.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param numSlots Number of slots needed.
+ * 
+ * @return 1 if successful, 0 if there is no memory.
+ */
+int reserva_lotes(Sistema *sistema, int numSlots) {
+    while (sistema->capacidadeLotes < numSlots) {
+        if (!novo_bloco_lotes(sistema)) return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Returns the slot of a batch to the free slots.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param slot Slot of the batch.
+ * 
+ * @note The array of free slots can hold every slot, so it never grows here.
+ */
+void liberta_slot_lote(Sistema *sistema, int slot) {
+    sistema->lotesLivres[sistema->numLotesLivres++] = slot;
+}
+
+/**
+ * @brief Frees the memory allocated for the batches.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ */
+void liberta_lotes(Sistema *sistema) {
+    for (int i = 0; i < sistema->numBlocosLotes; i++) {
+        free(sistema->blocosLotes[i]);
+    }
+    free(sistema->blocosLotes);
+    free(sistema->ordemLotes);
+    free(sistema->lotesLivres);
+    liberta_indice_nomes(&sistema->indiceLotes);
+}
+
+/**
+ * @brief Adds a new segment of inoculations to the system, doubling
+ * the array of segments when full.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * 
+ * @return 1 if successful, 0 if there is no memory.
+ */
+static int novo_segmento_inoculacoes(Sistema *sistema) {
+    if (sistema->numSegmentosInoculacoes == sistema->capacidadeSegmentosInoculacoes) {
+        int numSegmentos = sistema->capacidadeSegmentosInoculacoes ?
+                           2 * sistema->capacidadeSegmentosInoculacoes : 4;
+        if (!cresce_memoria(sistema, (void **)&sistema->segmentosInoculacoes,
+                            sistema->numSegmentosInoculacoes * sizeof(Inoculacao *),
+                            numSegmentos * sizeof(Inoculacao *))) {
+            return 0;
+        }
+        sistema->capacidadeSegmentosInoculacoes = numSegmentos;
+    }
+    Inoculacao *segmento = (Inoculacao *)malloc(INOCULACOES_POR_SEGMENTO * sizeof(Inoculacao));
+    if (segmento == NULL) return 0;
+    sistema->segmentosInoculacoes[sistema->numSegmentosInoculacoes++] = segmento;
+    return 1;
+}
+
+/**
+ * @brief Makes room for a number of inoculation positions, adding
+ * segments until they fit.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param numInoculacoes Number of positions needed.
+ * 
+ * @return 1 if successful, 0 if there is no memory.
+ * 
+ * @note The inoculations already in the system are not moved.
+ */
+int reserva_inoculacoes(Sistema *sistema, int numInoculacoes) {
+    while ((long long)sistema->numSegmentosInoculacoes * INOCULACOES_POR_SEGMENTO <
+           numInoculacoes) {
+        if (!novo_segmento_inoculacoes(sistema)) return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Adds a new inoculation in a position, reusing the positions
+ * of deleted inoculations first, and links it after the others in the
+ * current version. It is filled before it is linked, so the listings
+ * following the links see it whole.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param utente Id of the user.
+ * @param lote Slot of the batch.
+ * @param data Date of the inoculation.
+ * 
+ * @return The position of the new inoculation, -1 if there is no memory.
+ * 
+ * @note Adding a segment moves the array of segments, so while the
+ * system is shared the inoculation is filled here, under the lock of
+ * the inoculations.
+ */
+int nova_inoculacao(Sistema *sistema, int utente, int lote, Data data) {
+    int pos = sistema->inoculacaoLivre;
+    if (pos != -1) {
+        sistema->inoculacaoLivre = obtem_inoculacao(sistema, pos)->seguinte;
+    } else {
+        if (!reserva_inoculacoes(sistema, sistema->topoInoculacoes + 1)) return -1;
+        pos = sistema->topoInoculacoes++;
+    }
+    Inoculacao *inoculacao = obtem_inoculacao(sistema, pos);
+    inoculacao->utente = utente;
+    inoculacao->lote = lote;
+    inoculacao->data = data;
+    inoculacao->criada = sistema->versoes.atual;
+    inoculacao->apagada = VERSAO_VIVA;
+    inoculacao->anterior = sistema->ultimaInoculacao;
+    inoculacao->seguinte = -1;
+    if (sistema->ultimaInoculacao != -1) {
+        __atomic_store_n(&obtem_inoculacao(sistema, sistema->ultimaInoculacao)->seguinte, pos,
+                         __ATOMIC_RELEASE);
+    } else {
+        sistema->primeiraInoculacao = pos;
+    }
+    sistema->ultimaInoculacao = pos;
+    sistema->numInoculacoes++;
+    return pos;
+}
+
+/**
+ * @brief Deletes an inoculation, which stops being counted at once and
+ * is unlinked and its position reused once no listing shows it.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param pos Position of the inoculation.
+ */
+void apaga_inoculacao(Sistema *sistema, int pos) {
+    sistema->numInoculacoes--;
+    retira_inoculacao(sistema, pos);
+}
+
+/**
+ * @brief Unlinks a deleted inoculation from the others. It still links
+ * to the next one, so a listing that is on it goes on.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param pos Position of the inoculation.
+ */
+void desliga_inoculacao(Sistema *sistema, int pos) {
+    Inoculacao *inoculacao = obtem_inoculacao(sistema, pos);
+    if (inoculacao->anterior != -1) {
+        __atomic_store_n(&obtem_inoculacao(sistema, inoculacao->anterior)->seguinte,
+                         inoculacao->seguinte, __ATOMIC_RELEASE);
+    } else {
+        sistema->primeiraInoculacao = inoculacao->seguinte;
+    }
+    if (inoculacao->seguinte != -1) {
+        obtem_inoculacao(sistema, inoculacao->seguinte)->anterior = inoculacao->anterior;
+    } else {
+        sistema->ultimaInoculacao = inoculacao->anterior;
+    }
+}
+
+/**
+ * @brief Keeps the position of an unlinked inoculation for a new inoculation.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param pos Position of the inoculation.
+ */
+void liberta_inoculacao(Sistema *sistema, int pos) {
+    Inoculacao *inoculacao = obtem_inoculacao(sistema, pos);
+    inoculacao->utente = -1;
+    inoculacao->seguinte = sistema->inoculacaoLivre;
+    sistema->inoculacaoLivre = pos;
+}
+
+/**
+ * @brief Makes the first positions hold all the inoculations, linked
+ * in the order of their positions, with no deleted positions, as added
+ * before every version.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param numInoculacoes Number of inoculations, already in their positions.
+ */
+void encadeia_inoculacoes(Sistema *sistema, int numInoculacoes) {
+    for (int i = 0; i < numInoculacoes; i++) {
+        Inoculacao *inoculacao = obtem_inoculacao(sistema, i);
+        inoculacao->criada = 0;
+        inoculacao->apagada = VERSAO_VIVA;
+        inoculacao->anterior = i - 1;
+        inoculacao->seguinte = i + 1 < numInoculacoes ? i + 1 : -1;
+    }
+    sistema->numInoculacoes = sistema->topoInoculacoes = numInoculacoes;
+    sistema->primeiraInoculacao = numInoculacoes > 0 ? 0 : -1;
+    sistema->ultimaInoculacao = numInoculacoes - 1;
+    sistema->inoculacaoLivre = -1;
+}
+
+/**
+ * @brief Frees the memory allocated for the inoculations, one segment
+ * at a time.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ */
+void liberta_inoculacoes(Sistema *sistema) {
+    for (int i = 0; i < sistema->numSegmentosInoculacoes; i++) {
+        free(sistema->segmentosInoculacoes[i]);
+    }
+    free(sistema->segmentosInoculacoes);
+}
+
+/**
+ * @brief Keeps a copy of a name in an arena of names, after the names
+ * before it. Names longer than a block get a block of their own.
+ * 
+ * @param arena Pointer to the arena of names.
+ * @param nome Name to keep.
+ * 
+ * @return The copy of the name, which lives as long as the arena, or
+ * NULL if there is no memory.
+ */
+char *guarda_nome(ArenaNomes *arena, const char *nome) {
+    long long tamanho = (long long)strlen(nome) + 1;
+    if (tamanho > arena->livres) {
+        if (arena->numBlocos == arena->capacidadeBlocos) {
+            int numBlocos = arena->capacidadeBlocos ? 2 * arena->capacidadeBlocos : 16;
+            char **blocos = (char **)realloc(arena->blocos, numBlocos * sizeof(char *));
+            if (blocos == NULL) return NULL;
+            arena->blocos = blocos;
+            arena->capacidadeBlocos = numBlocos;
+        }
+        long long tamanhoBloco = tamanho > TAM_BLOCO_NOMES ? tamanho : TAM_BLOCO_NOMES;
+        char *bloco = (char *)malloc(tamanhoBloco);
+        if (bloco == NULL) return NULL;
+        arena->reservados += tamanhoBloco;
+        arena->blocos[arena->numBlocos++] = bloco;
+        if (tamanho > TAM_BLOCO_NOMES) {
+            // A long name fills its own block, and the free part of the other stays in use.
+            memcpy(bloco, nome, tamanho);
+            arena->usados += tamanho;
+            return bloco;
+        }
+        arena->livre = bloco;
+        arena->livres = tamanhoBloco;
+    }
+    char *copia = arena->livre;
+    memcpy(copia, nome, tamanho);
+    arena->livre += tamanho;
+    arena->livres -= tamanho;
+    arena->usados += tamanho;
+    return copia;
+}
+
+/**
+ * @brief Frees the memory allocated for an arena of names, one block at a time.
+ * 
+ * @param arena Pointer to the arena of names.
+ */
+void liberta_nomes(ArenaNomes *arena) {
+    for (int i = 0; i < arena->numBlocos; i++) {
+        free(arena->blocos[i]);
+    }
+    free(arena->blocos);
+}
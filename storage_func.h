@@ -0,0 +1,108 @@
+/**
+ * Declarations for the storage of the batches, the inoculations
+ * and the names of the vaccination system.
+ * @file: storage_func.h
+ * @author: ist1114613 (João Tamagnini)
+ */
+#ifndef STORAGE_FUNC_H
+#define STORAGE_FUNC_H
+#include "headers.h"
+
+/// @defgroup storage_funcs Storage functions.
+/// @{
+
+/**
+ * @brief Gets the batch stored in a slot.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param slot Slot of the batch.
+ * 
+ * @return Pointer to the batch, which stays valid while the batch exists.
+ */
+static inline Lote *obtem_lote(Sistema *sistema, int slot) {
+    Lote **blocos = __atomic_load_n(&sistema->blocosLotes, __ATOMIC_ACQUIRE);
+    return &blocos[slot / LOTES_POR_BLOCO][slot % LOTES_POR_BLOCO];
+}
+
+/// Gets a free slot for a new batch.
+int novo_slot_lote(Sistema *sistema);
+
+/// Makes room for a number of batch slots.
+int reserva_lotes(Sistema *sistema, int numSlots);
+
+/// Returns the slot of a batch to the free slots.
+void liberta_slot_lote(Sistema *sistema, int slot);
+
+/// Frees the memory allocated for the batches.
+void liberta_lotes(Sistema *sistema);
+
+/**
+ * @brief Gets the inoculation stored in a position.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param pos Position of the inoculation.
+ * 
+ * @return Pointer to the inoculation, which stays valid while the
+ * inoculation exists.
+ */
+static inline Inoculacao *obtem_inoculacao(Sistema *sistema, int pos) {
+    Inoculacao **segmentos = __atomic_load_n(&sistema->segmentosInoculacoes, __ATOMIC_ACQUIRE);
+    return &segmentos[pos / INOCULACOES_POR_SEGMENTO][pos % INOCULACOES_POR_SEGMENTO];
+}
+
+/**
+ * @brief Gets the shard of a user from its id.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param utente Id of the user.
+ * 
+ * @return Pointer to the shard of the user.
+ */
+static inline FatiaUtentes *obtem_fatia_utentes(Sistema *sistema, int utente) {
+    return &sistema->fatiasUtentes[utente & (NUM_FATIAS - 1)];
+}
+
+/**
+ * @brief Gets a user from its id.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param utente Id of the user.
+ * 
+ * @return Pointer to the user, which stays valid until another user
+ * is registered in its shard. Its name stays valid while the system exists.
+ */
+static inline Utente *obtem_utente(Sistema *sistema, int utente) {
+    Utente *utentes = __atomic_load_n(&obtem_fatia_utentes(sistema, utente)->utentes,
+                                      __ATOMIC_ACQUIRE);
+    return &utentes[utente >> BITS_FATIAS];
+}
+
+/// Makes room for a number of inoculation positions.
+int reserva_inoculacoes(Sistema *sistema, int numInoculacoes);
+
+/// Adds a new inoculation, linked after the others, and gets its position.
+int nova_inoculacao(Sistema *sistema, int utente, int lote, Data data);
+
+/// Deletes an inoculation, keeping its position for a new one once no listing shows it.
+void apaga_inoculacao(Sistema *sistema, int pos);
+
+/// Unlinks a deleted inoculation from the others.
+void desliga_inoculacao(Sistema *sistema, int pos);
+
+/// Keeps the position of an unlinked inoculation for a new one.
+void liberta_inoculacao(Sistema *sistema, int pos);
+
+/// Links the inoculations in the first positions in order.
+void encadeia_inoculacoes(Sistema *sistema, int numInoculacoes);
+
+/// Frees the memory allocated for the inoculations.
+void liberta_inoculacoes(Sistema *sistema);
+
+/// Keeps a copy of a name in an arena of names.
+char *guarda_nome(ArenaNomes *arena, const char *nome);
+
+/// Frees the memory allocated for an arena of names.
+void liberta_nomes(ArenaNomes *arena);
+
+/// @}
+#endif
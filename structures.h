@@ -1,37 +1,299 @@
-/**
- * A file containing the structures used throughout the project.
- * 
- * @file: structures.h
- * @author: ist1114613 (João Tamagnini)
- */
-#ifndef STRUCTURES
-#define STRUCTURES
-#include "constants.h"
-
-/// Structure representing a inoculation.
-typedef struct {
-    char *nomeUtente;
-    char lote[MAX_LOTE];
-    int dia, mes, ano;
-} Inoculacao;
-
-/// Structure representing a vaccine batch.
-typedef struct {
-    int dia, mes, ano;
-    char nome[MAX_NOME];
-    int quantidade;
-    char lote[MAX_LOTE];
-    Inoculacao *inoculacoes;
-    int numInoculacoes;
-} Lote;
-
-/// Structure representing the vaccination system.
-typedef struct {
-    Lote lotes[MAX_LOTES];
-    int numLotes;
-    Inoculacao *inoculacoes;
-    int numInoculacoes;
-    int dia_atual, mes_atual, ano_atual;
-    int capacidadeInoculacoes;
-} Sistema;
+/**
+ * A file containing the structures used throughout the project.
+ * 
+ * @file: structures.h
+ * @author: ist1114613 (João Tamagnini)
+ */
+#ifndef STRUCTURES
+#define STRUCTURES
+#include "constants.h"
+
+/// Date packed as (year << 9) | (month << 5) | day, ordered like the dates.
+typedef int Data;
+
+/// Structure representing a inoculation, linked to the previous and next ones in insertion order, with the versions of the system in which it was added and deleted.
+typedef struct {
+    int utente;
+    int lote;
+    Data data;
+    unsigned int criada, apagada;
+    int anterior, seguinte;
+} Inoculacao;
+
+/// Structure representing a vaccine batch.
+typedef struct {
+    Data data;
+    char nome[MAX_NOME + 1];
+    int quantidade;
+    char lote[MAX_LOTE + 1];
+    int numInoculacoes;
+    int vacina;
+    int posHeap;
+    int slot;
+} Lote;
+
+/// Structure representing a batch as seen by a listing: its slot, and the values that change kept as they were at the version of the listing.
+typedef struct {
+    int slot;
+    Data data;
+    int quantidade, numInoculacoes;
+} VersaoLote;
+
+/// Structure representing a hash index from names to ids.
+typedef struct {
+    const char **nomes;
+    int *ids;
+    int capacidade;
+    int tamanho;
+} IndiceNomes;
+
+/// Structure representing an arena where names are kept one after the other, in blocks.
+typedef struct {
+    char **blocos;
+    int numBlocos, capacidadeBlocos;
+    char *livre;
+    long long livres, reservados, usados;
+} ArenaNomes;
+
+/// Structure representing a user and the positions of its inoculations.
+typedef struct {
+    char *nome;
+    int *inoculacoes;
+    int numInoculacoes, capacidadeInoculacoes;
+} Utente;
+
+/// Structure representing the key of a vaccination (user, vaccine and date).
+typedef struct {
+    int utente;
+    int vacina;
+    Data data;
+} ChaveVacinacao;
+
+/// Structure representing a hash set of vaccinations.
+typedef struct {
+    ChaveVacinacao *chaves;
+    int capacidade;
+    int tamanho;
+} ConjuntoVacinacoes;
+
+/// Structure representing a shard of the users, with their index, their vaccinations and their names, which clients vaccinating at the same time lock apart.
+typedef struct {
+    _Alignas(TAM_LINHA_CACHE) pthread_mutex_t bloqueio;
+    Utente *utentes;
+    int numUtentes, capacidadeUtentes;
+    IndiceNomes indice;
+    ConjuntoVacinacoes vacinacoes;
+    ArenaNomes nomes;
+} FatiaUtentes;
+
+/// Structure representing a shard of the vaccines, whose lock guards their heaps and the stock of their batches.
+typedef struct {
+    _Alignas(TAM_LINHA_CACHE) pthread_mutex_t bloqueio;
+} FatiaVacinas;
+
+/// Structure representing a vaccine and its batches with stock.
+typedef struct {
+    char *nome;
+    int *heap;
+    int tamanhoHeap, capacidadeHeap;
+} Vacina;
+
+/// Structure representing memory, a batch slot or an inoculation that was retired while listings were running, with the version it was retired in.
+typedef struct {
+    unsigned int versao;
+    int tipo, pos;
+    void *memoria;
+} Retirado;
+
+/// Structure representing the versions of the system taken by the listings that are running, and what was retired while they run.
+typedef struct {
+    unsigned int atual, recolhida;
+    unsigned int leitores[MAX_FIOS];
+    int numLeitores;
+    Retirado *retirados;
+    int numRetirados, capacidadeRetirados;
+    pthread_mutex_t bloqueio;
+} Versoes;
+
+/// Structure representing the threads that help format large listings, each formatting its slice of each round of inoculations into a text of its own, which the thread of the listing writes in order.
+typedef struct {
+    pthread_t *fios;
+    int numFios, numIniciados;
+    int *posicoes;
+    int numPosicoes, capacidadePosicoes;
+    char **textos;
+    int *tamanhos;
+    unsigned int ronda;
+    int numPendentes, parar;
+    pthread_mutex_t bloqueio, ocupados;
+    pthread_cond_t inicio, fim;
+} Formatadores;
+
+/// Structure representing the vaccination system.
+typedef struct {
+    Lote **blocosLotes;
+    int numBlocosLotes, capacidadeBlocosLotes;
+    int numLotes, maxLotes;
+    int *lotesLivres;
+    int numLotesLivres, topoLotes, capacidadeLotes;
+    IndiceNomes indiceLotes;
+    int *ordemLotes;
+    Vacina *vacinas;
+    int numVacinas, capacidadeVacinas;
+    IndiceNomes indiceVacinas;
+    FatiaVacinas fatiasVacinas[NUM_FATIAS];
+    FatiaUtentes fatiasUtentes[NUM_FATIAS];
+    Inoculacao **segmentosInoculacoes;
+    int numSegmentosInoculacoes, capacidadeSegmentosInoculacoes;
+    int numInoculacoes, topoInoculacoes;
+    int primeiraInoculacao, ultimaInoculacao, inoculacaoLivre;
+    ArenaNomes nomes;
+    Data data_atual;
+    unsigned int numAlteracoes;
+    Versoes versoes;
+    Formatadores formatadores;
+    pthread_rwlock_t bloqueio;
+    pthread_mutex_t bloqueioInoculacoes;
+    int concorrente;
+} Sistema;
+
+/// Structure representing the memory taken by a data structure, in bytes.
+typedef struct {
+    long long reservados, usados, sobrecarga;
+} ContagemMemoria;
+
+/// Structure representing the header of a snapshot file.
+typedef struct {
+    char magica[8];
+    int versao;
+    int tamanhoLote, tamanhoInoculacao, tamanhoChave;
+    long long posicaoJournal;
+} CabecalhoSnapshot;
+
+/// Structure representing a date already formatted as dd-mm-yyyy.
+typedef struct {
+    Data data;
+    int tamanho;
+    char texto[16];
+} DataFormatada;
+
+/// Structure representing a block of commands or of output, passed between the stages of the pipeline.
+typedef struct {
+    char *dados;
+    int tamanho, capacidade;
+} Bloco;
+
+/// Structure representing a lock-free ring of blocks with a single producer and a single consumer, which sleeps while the ring is empty.
+typedef struct {
+    _Alignas(TAM_LINHA_CACHE) unsigned int escrita;
+    int esperando;
+    _Alignas(TAM_LINHA_CACHE) unsigned int leitura;
+    Bloco *blocos[2 * NUM_BLOCOS_PIPELINE];
+} Anel;
+
+/// Structure representing the blocks between two stages of the pipeline, which go forward full in a ring and come back empty in another.
+typedef struct {
+    Anel cheios, vazios;
+} Canal;
+
+/// Structure representing an output, which writes its text in large blocks, or passes them to the writer of a pipeline, and counts the errors written to it, in its own counts or in those it shares.
+typedef struct {
+    int fd;
+    char *buffer;
+    int capacidade, tamanho;
+    Canal *canal;
+    Bloco *bloco;
+    DataFormatada datas[TAM_CACHE_DATAS];
+    long long erros[NUM_TIPOS_ERRO];
+    long long *numErros;
+} Saida;
+
+/// Structure representing the header of a journal file.
+typedef struct {
+    char magica[8];
+    int versao;
+} CabecalhoJournal;
+
+/// Structure representing the header of a record of a journal file.
+typedef struct {
+    int tamanho;
+    unsigned int soma;
+} CabecalhoRegisto;
+
+/// Structure representing a journal, where the commands that change the system are appended.
+typedef struct {
+    int fd;
+    char *buffer;
+    int capacidade, tamanho;
+    long long posicao;
+    int porSincronizar, sincronizarCada, sincronizarMs;
+    long long inicioPorSincronizar;
+    int falhou;
+    pthread_mutex_t bloqueio;
+    int concorrente;
+} Journal;
+
+/// Structure representing a record of the journal, prepared before its command runs and appended if it changes the system.
+typedef struct {
+    Journal *journal;
+    char *dados;
+    int tamanho;
+    char local[TAM_REGISTO_LOCAL];
+} RegistoJournal;
+
+/// Structure representing the latencies of a command, kept in a log-linear histogram.
+typedef struct {
+    long long numComandos, totalNs, maximoNs;
+    long long baldes[NUM_BALDES_LATENCIA];
+} LatenciasComando;
+
+/// Structure representing the statistics of the commands run, by thread and by command letter.
+typedef struct {
+    LatenciasComando *comandos;
+    int numFios;
+} Estatisticas;
+
+/// Structure representing a reader of commands, which reads the input in blocks.
+typedef struct {
+    FILE *ficheiro;
+    Saida *saida;
+    Journal *journal;
+    char *buffer;
+    int capacidade;
+    int inicio, fim;
+    int fimFicheiro;
+    long long numLeituras;
+} Leitor;
+
+/// Structure representing a client of the server, with the commands it sent that were not run yet and the answers it was not sent yet.
+typedef struct {
+    int fd, posicao;
+    unsigned int eventos;
+    char *entrada;
+    int capacidade, inicio, fim;
+    int fimEntrada, emEspera;
+    Saida saida;
+} Conexao;
+
+/// Structure representing the pipeline that runs the commands of a reader in three stages: the parser and the writer threads, and the executor, which is the thread that starts it.
+typedef struct {
+    Canal comandos, saidas;
+    Bloco blocos[2 * NUM_BLOCOS_PIPELINE];
+    Leitor *leitor;
+    int fd;
+    pthread_t analisador, escritor;
+} Pipeline;
+
+/// Structure representing a thread of the server, which serves its own clients and shares the socket, the system, the journal and the statistics with the other threads.
+typedef struct {
+    int fio, epoll, fd, parar;
+    pthread_t thread;
+    Conexao **conexoes;
+    int numConexoes, capacidadeConexoes;
+    Sistema *sistema;
+    Journal *journal;
+    Estatisticas *estatisticas;
+    Saida *saida;
+    char *current_language;
+} Trabalhador;
 #endif
\ No newline at end of file
@@ -0,0 +1,246 @@
+/**
+ * Implementation of the versions of the vaccination system, which let
+ * the listings read it as it was when they started while the other
+ * commands change it.
+ * 
+ * Each listing takes a version of its own, and the inoculations keep
+ * the versions in which they were added and deleted, so a listing only
+ * shows those alive at its version and never locks the system for
+ * longer than taking it. What the other commands delete or replace
+ * meanwhile is retired with the current version, and only unlinked,
+ * reused or freed once every listing still running started after it.
+ * 
+ * A listing takes its version with the system locked in shared mode
+ * and the inoculations locked, so the versions are ordered with the
+ * vaccinations, and the other commands never run while it takes it.
+ * @file: version_func.c
+ * @author: ist1114613 (João Tamagnini)
+ */
+#include "headers.h"
+
+/**
+ * @brief Gets the oldest version taken by a listing still running.
+ * 
+ * @param versoes Pointer to the versions of the system.
+ * 
+ * @return The oldest version, or the current version if no listing is running.
+ */
+static unsigned int versao_minima(const Versoes *versoes) {
+    unsigned int minima = versoes->atual;
+    for (int i = 0; i < versoes->numLeitores; i++) {
+        if (versoes->leitores[i] < minima) minima = versoes->leitores[i];
+    }
+    return minima;
+}
+
+/**
+ * @brief Keeps something retired in the current version.
+ * 
+ * @param versoes Pointer to the versions of the system.
+ * @param tipo Type of what is retired.
+ * @param pos Slot of the batch or position of the inoculation.
+ * @param memoria Memory retired, or NULL.
+ * 
+ * @return 1 if successful, 0 if there is no memory, in which case it
+ * is never reused.
+ */
+static int acrescenta_retirado(Versoes *versoes, int tipo, int pos, void *memoria) {
+    if (versoes->numRetirados == versoes->capacidadeRetirados) {
+        int capacidade = versoes->capacidadeRetirados ? 2 * versoes->capacidadeRetirados : 64;
+        Retirado *retirados =
+            (Retirado *)realloc(versoes->retirados, capacidade * sizeof(Retirado));
+        if (retirados == NULL) return 0;
+        versoes->retirados = retirados;
+        versoes->capacidadeRetirados = capacidade;
+    }
+    Retirado *retirado = &versoes->retirados[versoes->numRetirados++];
+    retirado->versao = versoes->atual;
+    retirado->tipo = tipo;
+    retirado->pos = pos;
+    retirado->memoria = memoria;
+    return 1;
+}
+
+/**
+ * @brief Frees, reuses or unlinks what was retired before the oldest
+ * listing still running. An unlinked inoculation may still be where a
+ * listing is, so it is only reused once the listings running now end.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * 
+ * @note The versions must be locked, and the system locked alone, or
+ * in shared mode with the inoculations locked. What is retired while
+ * listings run is newer than all of them, so nothing more is ready
+ * until the oldest listing ends and the work is skipped.
+ */
+static void recolhe_retirados(Sistema *sistema) {
+    Versoes *versoes = &sistema->versoes;
+    unsigned int minima = versao_minima(versoes);
+    if (versoes->numRetirados == 0 || minima == versoes->recolhida) return;
+    versoes->recolhida = minima;
+    int numRestantes = 0;
+    for (int i = 0; i < versoes->numRetirados; i++) {
+        Retirado retirado = versoes->retirados[i];
+        if (retirado.versao > minima) {
+            versoes->retirados[numRestantes++] = retirado;
+            continue;
+        }
+        switch (retirado.tipo) {
+            case RETIRADO_MEMORIA: free(retirado.memoria); break;
+            case RETIRADO_LOTE: liberta_slot_lote(sistema, retirado.pos); break;
+            case RETIRADO_INOCULACAO:
+                desliga_inoculacao(sistema, retirado.pos);
+                if (versoes->numLeitores > 0) {
+                    retirado.tipo = RETIRADO_DESLIGADA;
+                    retirado.versao = versoes->atual;
+                    versoes->retirados[numRestantes++] = retirado;
+                } else {
+                    liberta_inoculacao(sistema, retirado.pos);
+                }
+                break;
+            default: liberta_inoculacao(sistema, retirado.pos); break;
+        }
+    }
+    versoes->numRetirados = numRestantes;
+}
+
+/**
+ * @brief Takes a new version of the system for a listing that starts,
+ * after freeing what no listing can read anymore.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * 
+ * @return The version of the listing, which sees the changes made
+ * before it and none of those made after it.
+ * 
+ * @note The system must be locked in shared mode and the inoculations
+ * locked. The listing ends with termina_leitura.
+ */
+unsigned int inicia_leitura(Sistema *sistema) {
+    Versoes *versoes = &sistema->versoes;
+    bloqueia(&versoes->bloqueio, sistema->concorrente);
+    recolhe_retirados(sistema);
+    unsigned int versao = versoes->atual++;
+    versoes->leitores[versoes->numLeitores++] = versao;
+    desbloqueia(&versoes->bloqueio, sistema->concorrente);
+    return versao;
+}
+
+/**
+ * @brief Ends the listing of a version. What was retired before it is
+ * reused by the next command that retires something or starts a listing.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param versao Version of the listing.
+ */
+void termina_leitura(Sistema *sistema, unsigned int versao) {
+    Versoes *versoes = &sistema->versoes;
+    bloqueia(&versoes->bloqueio, sistema->concorrente);
+    for (int i = 0; i < versoes->numLeitores; i++) {
+        if (versoes->leitores[i] == versao) {
+            versoes->leitores[i] = versoes->leitores[--versoes->numLeitores];
+            break;
+        }
+    }
+    desbloqueia(&versoes->bloqueio, sistema->concorrente);
+}
+
+/**
+ * @brief Replaces an array that listings may be reading by a larger
+ * copy, and retires the old one.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param memoria Pointer to the array, which is set to the copy.
+ * @param tamanho Number of bytes in use in the array.
+ * @param novoTamanho Number of bytes of the copy.
+ * 
+ * @return 1 if successful, 0 if there is no memory.
+ */
+int cresce_memoria(Sistema *sistema, void **memoria, size_t tamanho, size_t novoTamanho) {
+    void *nova = malloc(novoTamanho);
+    if (nova == NULL) return 0;
+    void *antiga = *memoria;
+    if (tamanho > 0) memcpy(nova, antiga, tamanho);
+    __atomic_store_n(memoria, nova, __ATOMIC_RELEASE);
+    retira_memoria(sistema, antiga);
+    return 1;
+}
+
+/**
+ * @brief Retires memory, which is freed now if no listing is running,
+ * or once the listings running now end.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param memoria Memory to free, or NULL.
+ */
+void retira_memoria(Sistema *sistema, void *memoria) {
+    if (memoria == NULL) return;
+    Versoes *versoes = &sistema->versoes;
+    bloqueia(&versoes->bloqueio, sistema->concorrente);
+    if (versoes->numLeitores == 0) {
+        free(memoria);
+    } else {
+        acrescenta_retirado(versoes, RETIRADO_MEMORIA, 0, memoria);
+    }
+    desbloqueia(&versoes->bloqueio, sistema->concorrente);
+}
+
+/**
+ * @brief Retires the slot of a removed batch, which is reused now if
+ * no listing is running, or once the listings running now end.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param slot Slot of the batch.
+ * 
+ * @note The system must be locked alone.
+ */
+void retira_lote(Sistema *sistema, int slot) {
+    Versoes *versoes = &sistema->versoes;
+    bloqueia(&versoes->bloqueio, sistema->concorrente);
+    if (versoes->numLeitores == 0) {
+        liberta_slot_lote(sistema, slot);
+    } else {
+        acrescenta_retirado(versoes, RETIRADO_LOTE, slot, NULL);
+    }
+    recolhe_retirados(sistema);
+    desbloqueia(&versoes->bloqueio, sistema->concorrente);
+}
+
+/**
+ * @brief Deletes an inoculation in the current version. It is unlinked
+ * and its position reused now if no listing is running, or once no
+ * listing running shows it.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ * @param pos Position of the inoculation.
+ * 
+ * @note The system must be locked alone.
+ */
+void retira_inoculacao(Sistema *sistema, int pos) {
+    Versoes *versoes = &sistema->versoes;
+    bloqueia(&versoes->bloqueio, sistema->concorrente);
+    __atomic_store_n(&obtem_inoculacao(sistema, pos)->apagada, versoes->atual,
+                     __ATOMIC_RELAXED);
+    if (versoes->numLeitores == 0) {
+        desliga_inoculacao(sistema, pos);
+        liberta_inoculacao(sistema, pos);
+    } else {
+        acrescenta_retirado(versoes, RETIRADO_INOCULACAO, pos, NULL);
+    }
+    recolhe_retirados(sistema);
+    desbloqueia(&versoes->bloqueio, sistema->concorrente);
+}
+
+/**
+ * @brief Frees the memory that is still retired and the list of what
+ * was retired, once no listing is running.
+ * 
+ * @param sistema Pointer to the vaccination system structure.
+ */
+void liberta_versoes(Sistema *sistema) {
+    Versoes *versoes = &sistema->versoes;
+    for (int i = 0; i < versoes->numRetirados; i++) {
+        if (versoes->retirados[i].tipo == RETIRADO_MEMORIA) free(versoes->retirados[i].memoria);
+    }
+    free(versoes->retirados);
+}
@@ -0,0 +1,50 @@
+/**
+ * Declarations for the versions of the vaccination system, which let
+ * the listings read it as it was when they started.
+ * @file: version_func.h
+ * @author: ist1114613 (João Tamagnini)
+ */
+#ifndef VERSION_FUNC_H
+#define VERSION_FUNC_H
+#include "headers.h"
+
+/// @defgroup version_funcs Version functions.
+/// @{
+
+/**
+ * @brief Checks if an inoculation is seen by a listing, which is when
+ * it was added and not deleted at the version of the listing.
+ * 
+ * @param inoculacao Pointer to the inoculation.
+ * @param versao Version of the listing.
+ * 
+ * @return 1 if the listing shows the inoculation, 0 otherwise.
+ */
+static inline int inoculacao_visivel(const Inoculacao *inoculacao, unsigned int versao) {
+    return inoculacao->criada <= versao &&
+           __atomic_load_n(&inoculacao->apagada, __ATOMIC_RELAXED) > versao;
+}
+
+/// Takes a new version of the system for a listing that starts.
+unsigned int inicia_leitura(Sistema *sistema);
+
+/// Ends the listing of a version, so what was retired before it can be reused.
+void termina_leitura(Sistema *sistema, unsigned int versao);
+
+/// Replaces an array that listings may be reading by a larger copy.
+int cresce_memoria(Sistema *sistema, void **memoria, size_t tamanho, size_t novoTamanho);
+
+/// Retires memory, which is freed once no listing can read it.
+void retira_memoria(Sistema *sistema, void *memoria);
+
+/// Retires the slot of a removed batch, which is reused once no listing can read it.
+void retira_lote(Sistema *sistema, int slot);
+
+/// Deletes an inoculation in the current version, unlinking it once no listing shows it.
+void retira_inoculacao(Sistema *sistema, int pos);
+
+/// Frees what is still retired, once no listing is running.
+void liberta_versoes(Sistema *sistema);
+
+/// @}
+#endif